@@ -0,0 +1,724 @@
+/*
+    bench.c -- statistical compile-time benchmark runner
+
+    Runs each benchmark variant (a compiler command line) a number of
+    warmup times, and then times each run individually. The command is
+    started directly via fork/execvp (no shell in between), the wall-clock
+    time is measured around fork/wait4, and the peak RSS of the child process
+    is taken from the rusage returned by wait4.
+
+    Build:
+        cc -O2 -o bench bench.c -lm
+
+    Usage:
+        ./bench [options] name 'command' [name 'command' ...]
+
+    Options:
+        -w N        number of untimed warmup runs per variant (default: 5)
+        -n N        number of timed runs per variant (default: 100)
+        -j FILE     write JSON results (summary + all samples) to FILE
+        -c FILE     write CSV summary to FILE (one line per variant)
+        -m KEY=VAL  add a metadata key/value pair to the JSON output
+                    (e.g. -m "compiler=$(cc --version | head -1)")
+        -q          don't print the result table to stdout
+        -r REF:A,B  normalize variants A and B against variant REF (the
+                    REF mean and median are subtracted), to factor out the
+                    per-host process startup cost (e.g. -r empty_c:decl-orig)
+        -b FILE     compare the normalized results against a baseline JSON
+                    file written by an earlier run with -j, and exit with
+                    status 1 if any variant regressed significantly
+        -t PCT      regression threshold in percent for -b (default: 5)
+        -p CPU      pin the compiler processes to CPU (via sched_setaffinity),
+                    ideally an isolated core (e.g. isolcpus=3 and -p 3)
+        -i          interleave the variants: instead of running all runs of
+                    one variant before the next, run one run of each variant
+                    per round (the start variant rotates each round), so that
+                    thermal drift and background load hit all variants alike
+        -d          correct linear drift: fit each variant's times against
+                    the run timestamps and remove the slope before computing
+                    the statistics (the fitted drift is always reported)
+        -R FILE     write every single run to a CSV FILE (variant, run index,
+                    start timestamp, wall/cpu time, rss)
+        -u NAME     add a column to the result table which expresses each
+                    variant's normalized median as multiple of variant NAME
+                    (e.g. -u stdvector: 'decl-orig costs 0.2 x <vector>')
+
+    Example:
+        ./bench -n 200 -j out.json \
+            empty_c   'cc -c empty.c -o empty.o' \
+            decl-orig 'cc -c decl-orig.c -o decl-orig.o'
+
+    Commands are split at whitespace, quoting inside a command is not
+    supported.
+
+    Low-noise runs:
+        ./bench -i -d -p 3 -R runs.csv ...
+
+    Baseline comparison:
+        A variant counts as regressed when its normalized mean is more than
+        PCT percent above the baseline's normalized mean, and the difference
+        is significant in a one-sided Welch t-test at the 1% level (the
+        standard errors of the variant and its reference are combined, the
+        degrees of freedom come from the Welch-Satterthwaite equation, so
+        small -n runs need a larger difference).
+*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <sched.h>
+
+#define BENCH_MAX_ARGS (128)
+#define BENCH_MAX_META (16)
+#define BENCH_MAX_REFS (16)
+
+/* a single timed run */
+typedef struct {
+    double start_ms;    /* start time relative to the first run */
+    double wall_ms;     /* wall-clock time from fork to wait4 */
+    double cpu_ms;      /* user + system time of the child */
+    long rss_kb;        /* peak resident set size of the child */
+} run_t;
+
+/* summary statistics over all timed runs of a variant */
+typedef struct {
+    double mean;
+    double median;
+    double p95;
+    double stddev;
+    double min;
+    double max;
+    double cpu_mean;
+    long rss_peak_kb;
+    double drift;       /* fitted linear drift in ms per minute */
+} stats_t;
+
+/* normalized result (reference variant subtracted) */
+typedef struct {
+    double mean;
+    double median;
+    double sem;     /* standard error of the normalized mean */
+    double df;      /* Welch-Satterthwaite degrees of freedom of sem */
+} norm_t;
+
+/* a benchmark variant */
+typedef struct {
+    const char* name;
+    const char* cmd;
+    char* argv[BENCH_MAX_ARGS];
+    const char* ref;    /* name of reference variant, or 0 */
+    run_t* runs;
+    stats_t stats;
+    norm_t norm;
+} variant_t;
+
+static struct {
+    int num_warmup;
+    int num_runs;
+    const char* json_path;
+    const char* csv_path;
+    bool quiet;
+    int num_meta;
+    const char* meta[BENCH_MAX_META];
+    int num_refs;
+    const char* refs[BENCH_MAX_REFS];
+    const char* baseline_path;
+    double threshold;
+    const char* unit;
+    int pin_cpu;
+    bool interleave;
+    bool detrend;
+    const char* runs_path;
+    double start_ms;
+    int num_variants;
+    variant_t* variants;
+} bench;
+
+static void fatal(const char* msg, const char* arg) {
+    fprintf(stderr, "bench: %s%s%s\n", msg, arg ? ": " : "", arg ? arg : "");
+    exit(10);
+}
+
+static void usage(void) {
+    fprintf(stderr,
+        "usage: bench [-w warmup] [-n runs] [-j out.json] [-c out.csv] [-m key=val] [-q]\n"
+        "             [-r ref:name,name] [-b baseline.json] [-t percent] [-u unit]\n"
+        "             [-p cpu] [-i] [-d] [-R runs.csv]\n"
+        "             name 'command' [name 'command' ...]\n");
+    exit(10);
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
+
+static double tv_ms(struct timeval tv) {
+    return (double)tv.tv_sec * 1000.0 + (double)tv.tv_usec / 1000.0;
+}
+
+/* split a command line at whitespace into a NULL-terminated argv array */
+static void split_cmd(variant_t* v) {
+    char* str = strdup(v->cmd);
+    int argc = 0;
+    for (char* tok = strtok(str, " \t\n"); tok; tok = strtok(0, " \t\n")) {
+        if (argc >= (BENCH_MAX_ARGS - 1)) {
+            fatal("too many arguments in command", v->cmd);
+        }
+        v->argv[argc++] = tok;
+    }
+    if (argc == 0) {
+        fatal("empty command for variant", v->name);
+    }
+    v->argv[argc] = 0;
+}
+
+/* check that the CPU for -p exists and is available to this process */
+static void check_pin_cpu(void) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if ((bench.pin_cpu >= CPU_SETSIZE) || (sched_getaffinity(0, sizeof(set), &set) < 0) || !CPU_ISSET(bench.pin_cpu, &set)) {
+        fatal("CPU for -p not available", 0);
+    }
+}
+
+/* run the variant's command once, return timing and memory usage */
+static run_t run_once(const variant_t* v) {
+    run_t run;
+    memset(&run, 0, sizeof(run));
+    const double t0 = now_ms();
+    pid_t pid = fork();
+    if (pid < 0) {
+        fatal("fork() failed", v->name);
+    }
+    else if (pid == 0) {
+        if (bench.pin_cpu >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(bench.pin_cpu, &set);
+            if (sched_setaffinity(0, sizeof(set), &set) < 0) {
+                _exit(126);
+            }
+        }
+        execvp(v->argv[0], v->argv);
+        _exit(127);
+    }
+    int status = 0;
+    struct rusage ru;
+    if (wait4(pid, &status, 0, &ru) < 0) {
+        fatal("wait4() failed", v->name);
+    }
+    run.wall_ms = now_ms() - t0;
+    run.start_ms = t0 - bench.start_ms;
+    if (!WIFEXITED(status) || (WEXITSTATUS(status) != 0)) {
+        fatal("command failed", v->cmd);
+    }
+    run.cpu_ms = tv_ms(ru.ru_utime) + tv_ms(ru.ru_stime);
+    #if defined(__APPLE__)
+    run.rss_kb = ru.ru_maxrss / 1024;   /* bytes on macOS */
+    #else
+    run.rss_kb = ru.ru_maxrss;          /* kilobytes on Linux */
+    #endif
+    return run;
+}
+
+static int cmp_double(const void* a, const void* b) {
+    const double da = *(const double*)a;
+    const double db = *(const double*)b;
+    return (da < db) ? -1 : ((da > db) ? 1 : 0);
+}
+
+/* percentile with linear interpolation over a sorted array */
+static double percentile(const double* sorted, int num, double p) {
+    if (num == 1) {
+        return sorted[0];
+    }
+    const double pos = p * (num - 1);
+    const int i = (int)pos;
+    if (i >= (num - 1)) {
+        return sorted[num - 1];
+    }
+    const double frac = pos - i;
+    return sorted[i] + (sorted[i + 1] - sorted[i]) * frac;
+}
+
+/* least-squares slope of wall time over start time, in ms per minute */
+static double fit_drift(const run_t* runs, int num) {
+    double t_mean = 0.0, w_mean = 0.0;
+    for (int i = 0; i < num; i++) {
+        t_mean += runs[i].start_ms / 60000.0;
+        w_mean += runs[i].wall_ms;
+    }
+    t_mean /= num;
+    w_mean /= num;
+    double cov = 0.0, var = 0.0;
+    for (int i = 0; i < num; i++) {
+        const double dt = runs[i].start_ms / 60000.0 - t_mean;
+        cov += dt * (runs[i].wall_ms - w_mean);
+        var += dt * dt;
+    }
+    return (var > 0.0) ? (cov / var) : 0.0;
+}
+
+static stats_t compute_stats(const run_t* runs, int num) {
+    stats_t s;
+    memset(&s, 0, sizeof(s));
+    s.drift = fit_drift(runs, num);
+    /* the sample values, with the linear drift removed if requested */
+    double* values = (double*) malloc(num * sizeof(double));
+    double t_mean = 0.0;
+    for (int i = 0; i < num; i++) {
+        t_mean += runs[i].start_ms / 60000.0;
+    }
+    t_mean /= num;
+    for (int i = 0; i < num; i++) {
+        values[i] = runs[i].wall_ms;
+        if (bench.detrend) {
+            values[i] -= s.drift * (runs[i].start_ms / 60000.0 - t_mean);
+        }
+    }
+    double* sorted = (double*) malloc(num * sizeof(double));
+    double sum = 0.0;
+    double cpu_sum = 0.0;
+    for (int i = 0; i < num; i++) {
+        sorted[i] = values[i];
+        sum += values[i];
+        cpu_sum += runs[i].cpu_ms;
+        if (runs[i].rss_kb > s.rss_peak_kb) {
+            s.rss_peak_kb = runs[i].rss_kb;
+        }
+    }
+    qsort(sorted, num, sizeof(double), cmp_double);
+    s.mean = sum / num;
+    s.cpu_mean = cpu_sum / num;
+    double sq = 0.0;
+    for (int i = 0; i < num; i++) {
+        const double d = values[i] - s.mean;
+        sq += d * d;
+    }
+    s.stddev = (num > 1) ? sqrt(sq / (num - 1)) : 0.0;
+    s.median = percentile(sorted, num, 0.5);
+    s.p95 = percentile(sorted, num, 0.95);
+    s.min = sorted[0];
+    s.max = sorted[num - 1];
+    free(sorted);
+    free(values);
+    return s;
+}
+
+static bool is_reference(const char* name) {
+    for (int vi = 0; vi < bench.num_variants; vi++) {
+        const char* ref = bench.variants[vi].ref;
+        if (ref && (0 == strcmp(ref, name))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static variant_t* find_variant(const char* name) {
+    for (int vi = 0; vi < bench.num_variants; vi++) {
+        if (0 == strcmp(bench.variants[vi].name, name)) {
+            return &bench.variants[vi];
+        }
+    }
+    return 0;
+}
+
+/* resolve the -r options into per-variant reference names */
+static void assign_refs(void) {
+    for (int ri = 0; ri < bench.num_refs; ri++) {
+        char* str = strdup(bench.refs[ri]);
+        char* colon = strchr(str, ':');
+        if (!colon) {
+            fatal("reference must be REF:NAME,NAME,...", bench.refs[ri]);
+        }
+        *colon = 0;
+        if (!find_variant(str)) {
+            fatal("unknown reference variant", str);
+        }
+        for (char* tok = strtok(colon + 1, ","); tok; tok = strtok(0, ",")) {
+            variant_t* v = find_variant(tok);
+            if (!v) {
+                fatal("unknown variant in reference list", tok);
+            }
+            v->ref = str;
+        }
+    }
+}
+
+/* Welch-Satterthwaite degrees of freedom of the sum of two variances */
+static double welch_df(double var0, double df0, double var1, double df1) {
+    const double den = (var0 * var0) / df0 + (var1 * var1) / df1;
+    return (den > 0.0) ? ((var0 + var1) * (var0 + var1) / den) : (df0 + df1);
+}
+
+/* one-sided 1% critical value of Student's t distribution */
+static double t_crit(double df) {
+    static const double table[10] = { 0.0, 31.821, 6.965, 4.541, 3.747, 3.365, 3.143, 2.998, 2.896, 2.821 };
+    /* round down, which is the conservative direction */
+    const int idf = (int)df;
+    if (idf < 1) {
+        return table[1];
+    }
+    if (idf < 10) {
+        return table[idf];
+    }
+    /* Cornish-Fisher expansion around the normal quantile, exact to 1e-4 from df=10 */
+    const double z = 2.3263479;
+    const double z2 = z * z;
+    const double v = idf;
+    return z + z * (z2 + 1.0) / (4.0 * v)
+        + z * ((5.0 * z2 + 16.0) * z2 + 3.0) / (96.0 * v * v)
+        + z * (((3.0 * z2 + 19.0) * z2 + 17.0) * z2 - 15.0) / (384.0 * v * v * v)
+        + z * ((((79.0 * z2 + 776.0) * z2 + 1482.0) * z2 - 1920.0) * z2 - 945.0) / (92160.0 * v * v * v * v);
+}
+
+static norm_t compute_norm(const variant_t* v) {
+    norm_t n;
+    const stats_t* s = &v->stats;
+    const double se = s->stddev / sqrt((double)bench.num_runs);
+    n.mean = s->mean;
+    n.median = s->median;
+    n.sem = se;
+    n.df = bench.num_runs - 1;
+    if (v->ref) {
+        const stats_t* r = &find_variant(v->ref)->stats;
+        const double ref_se = r->stddev / sqrt((double)bench.num_runs);
+        n.mean -= r->mean;
+        n.median -= r->median;
+        n.sem = sqrt(se * se + ref_se * ref_se);
+        n.df = welch_df(se * se, bench.num_runs - 1, ref_se * ref_se, bench.num_runs - 1);
+    }
+    return n;
+}
+
+/* write a string as JSON string literal */
+static void json_str(FILE* fp, const char* str) {
+    fputc('"', fp);
+    for (const char* c = str; *c; c++) {
+        if ((*c == '"') || (*c == '\\')) {
+            fputc('\\', fp);
+            fputc(*c, fp);
+        }
+        else if ((unsigned char)*c < 0x20) {
+            fprintf(fp, "\\u%04x", *c);
+        }
+        else {
+            fputc(*c, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+static void write_json(const char* path) {
+    FILE* fp = fopen(path, "w");
+    if (!fp) {
+        fatal("failed to open output file", path);
+    }
+    fprintf(fp, "{\n  \"warmup\": %d,\n  \"runs\": %d,\n  \"interleave\": %s,\n  \"detrend\": %s,\n  \"pin_cpu\": %d,\n  \"meta\": {",
+        bench.num_warmup, bench.num_runs, bench.interleave ? "true" : "false", bench.detrend ? "true" : "false", bench.pin_cpu);
+    for (int i = 0; i < bench.num_meta; i++) {
+        const char* eq = strchr(bench.meta[i], '=');
+        char key[256];
+        snprintf(key, sizeof(key), "%.*s", (int)(eq - bench.meta[i]), bench.meta[i]);
+        fprintf(fp, "%s\n    ", (i > 0) ? "," : "");
+        json_str(fp, key);
+        fprintf(fp, ": ");
+        json_str(fp, eq + 1);
+    }
+    fprintf(fp, "%s},\n  \"variants\": [", (bench.num_meta > 0) ? "\n  " : "");
+    for (int vi = 0; vi < bench.num_variants; vi++) {
+        const variant_t* v = &bench.variants[vi];
+        const stats_t* s = &v->stats;
+        fprintf(fp, "%s\n    {\n      \"name\": ", (vi > 0) ? "," : "");
+        json_str(fp, v->name);
+        fprintf(fp, ",\n      \"cmd\": ");
+        json_str(fp, v->cmd);
+        if (v->ref) {
+            fprintf(fp, ",\n      \"ref\": ");
+            json_str(fp, v->ref);
+        }
+        fprintf(fp, ",\n      \"norm_mean_ms\": %.4f,\n      \"norm_median_ms\": %.4f,\n      \"norm_sem_ms\": %.4f,\n      \"norm_df\": %.2f",
+            v->norm.mean, v->norm.median, v->norm.sem, v->norm.df);
+        fprintf(fp, ",\n      \"mean_ms\": %.4f,\n      \"median_ms\": %.4f,\n      \"p95_ms\": %.4f,\n"
+                    "      \"stddev_ms\": %.4f,\n      \"min_ms\": %.4f,\n      \"max_ms\": %.4f,\n"
+                    "      \"cpu_mean_ms\": %.4f,\n      \"rss_peak_kb\": %ld,\n      \"drift_ms_per_min\": %.4f,\n"
+                    "      \"samples_ms\": [",
+            s->mean, s->median, s->p95, s->stddev, s->min, s->max, s->cpu_mean, s->rss_peak_kb, s->drift);
+        for (int i = 0; i < bench.num_runs; i++) {
+            fprintf(fp, "%s%.4f", (i > 0) ? ", " : "", v->runs[i].wall_ms);
+        }
+        fprintf(fp, "],\n      \"timestamps_ms\": [");
+        for (int i = 0; i < bench.num_runs; i++) {
+            fprintf(fp, "%s%.1f", (i > 0) ? ", " : "", v->runs[i].start_ms);
+        }
+        fprintf(fp, "]\n    }");
+    }
+    fprintf(fp, "\n  ]\n}\n");
+    fclose(fp);
+}
+
+static void write_csv(const char* path) {
+    FILE* fp = fopen(path, "w");
+    if (!fp) {
+        fatal("failed to open output file", path);
+    }
+    fprintf(fp, "name,runs,mean_ms,median_ms,p95_ms,stddev_ms,min_ms,max_ms,cpu_mean_ms,rss_peak_kb,drift_ms_per_min\n");
+    for (int vi = 0; vi < bench.num_variants; vi++) {
+        const variant_t* v = &bench.variants[vi];
+        const stats_t* s = &v->stats;
+        fprintf(fp, "%s,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%ld,%.4f\n",
+            v->name, bench.num_runs, s->mean, s->median, s->p95, s->stddev, s->min, s->max, s->cpu_mean, s->rss_peak_kb, s->drift);
+    }
+    fclose(fp);
+}
+
+/* write every run in start order, for plotting drift over time */
+static void write_runs(const char* path) {
+    FILE* fp = fopen(path, "w");
+    if (!fp) {
+        fatal("failed to open output file", path);
+    }
+    fprintf(fp, "name,run,start_ms,wall_ms,cpu_ms,rss_kb\n");
+    for (int vi = 0; vi < bench.num_variants; vi++) {
+        const variant_t* v = &bench.variants[vi];
+        for (int i = 0; i < bench.num_runs; i++) {
+            const run_t* r = &v->runs[i];
+            fprintf(fp, "%s,%d,%.3f,%.4f,%.4f,%ld\n", v->name, i, r->start_ms, r->wall_ms, r->cpu_ms, r->rss_kb);
+        }
+    }
+    fclose(fp);
+}
+
+/* read the whole file into a zero-terminated string */
+static char* read_file(const char* path) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        fatal("failed to open baseline file", path);
+    }
+    fseek(fp, 0, SEEK_END);
+    const long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    char* buf = (char*) malloc(size + 1);
+    if (fread(buf, 1, size, fp) != (size_t)size) {
+        fatal("failed to read baseline file", path);
+    }
+    buf[size] = 0;
+    fclose(fp);
+    return buf;
+}
+
+/* find a number value by key between start and end in a JSON string */
+static bool json_number(const char* start, const char* end, const char* key, double* out) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "\"%s\": ", key);
+    const char* p = strstr(start, pattern);
+    if (!p || (end && (p >= end))) {
+        return false;
+    }
+    *out = strtod(p + strlen(pattern), 0);
+    return true;
+}
+
+/* look up a variant's normalized result in a JSON file written by write_json() */
+static bool baseline_lookup(const char* json, const char* name, norm_t* out) {
+    const char* variants = strstr(json, "\"variants\": [");
+    if (!variants) {
+        return false;
+    }
+    char pattern[256];
+    snprintf(pattern, sizeof(pattern), "\"name\": \"%s\",", name);
+    const char* start = strstr(variants, pattern);
+    if (!start) {
+        return false;
+    }
+    const char* end = strstr(start + 1, "\"name\": ");
+    if (!json_number(start, end, "norm_df", &out->df)) {
+        /* older baselines have no degrees of freedom, assume runs-1 */
+        double runs = 0.0;
+        json_number(json, variants, "runs", &runs);
+        out->df = (runs > 1.0) ? (runs - 1.0) : 1.0;
+    }
+    return json_number(start, end, "norm_mean_ms", &out->mean) &&
+           json_number(start, end, "norm_median_ms", &out->median) &&
+           json_number(start, end, "norm_sem_ms", &out->sem);
+}
+
+/* compare against the baseline, returns number of regressed variants */
+static int compare_baseline(const char* path) {
+    char* json = read_file(path);
+    int num_regressed = 0;
+    printf("\nbaseline %s (threshold %.1f%%, normalized means)\n", path, bench.threshold);
+    printf("%-24s %10s %10s %9s %8s  %s\n", "variant", "base ms", "new ms", "change", "t", "result");
+    for (int vi = 0; vi < bench.num_variants; vi++) {
+        const variant_t* v = &bench.variants[vi];
+        if (is_reference(v->name)) {
+            printf("%-24s %10s %10.3f %9s %8s  %s\n", v->name, "-", v->norm.mean, "-", "-", "reference");
+            continue;
+        }
+        norm_t base;
+        if (!baseline_lookup(json, v->name, &base)) {
+            printf("%-24s %10s %10.3f %9s %8s  %s\n", v->name, "-", v->norm.mean, "-", "-", "not in baseline");
+            continue;
+        }
+        const double diff = v->norm.mean - base.mean;
+        const double change = (base.mean > 0.0) ? (100.0 * diff / base.mean) : 0.0;
+        const double se = sqrt(v->norm.sem * v->norm.sem + base.sem * base.sem);
+        const double t = (se > 0.0) ? (diff / se) : 0.0;
+        const double crit = t_crit(welch_df(v->norm.sem * v->norm.sem, v->norm.df, base.sem * base.sem, base.df));
+        const bool regressed = (change > bench.threshold) && (t > crit);
+        const bool improved = (change < -bench.threshold) && (t < -crit);
+        if (regressed) {
+            num_regressed++;
+        }
+        printf("%-24s %10.3f %10.3f %8.1f%% %8.2f  %s\n", v->name, base.mean, v->norm.mean, change, t,
+            regressed ? "REGRESSED" : (improved ? "improved" : "ok"));
+    }
+    free(json);
+    return num_regressed;
+}
+
+static void print_table(void) {
+    const variant_t* unit = bench.unit ? find_variant(bench.unit) : 0;
+    printf("%-24s %10s %10s %10s %10s %10s %11s", "variant", "mean ms", "median ms", "p95 ms", "stddev ms", "rss KB", "drift %/min");
+    if (unit) {
+        printf("  x %s", unit->name);
+    }
+    printf("\n");
+    for (int vi = 0; vi < bench.num_variants; vi++) {
+        const variant_t* v = &bench.variants[vi];
+        const stats_t* s = &v->stats;
+        printf("%-24s %10.3f %10.3f %10.3f %10.3f %10ld %11.2f",
+            v->name, s->mean, s->median, s->p95, s->stddev, s->rss_peak_kb, (s->mean > 0.0) ? (100.0 * s->drift / s->mean) : 0.0);
+        if (unit && v->ref && (unit->norm.median > 0.0)) {
+            printf("  %8.2f", v->norm.median / unit->norm.median);
+        }
+        printf("\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    bench.num_warmup = 5;
+    bench.num_runs = 100;
+    bench.threshold = 5.0;
+    bench.pin_cpu = -1;
+    int opt;
+    while ((opt = getopt(argc, argv, "w:n:j:c:m:qr:b:t:u:p:idR:")) != -1) {
+        switch (opt) {
+            case 'w': bench.num_warmup = atoi(optarg); break;
+            case 'n': bench.num_runs = atoi(optarg); break;
+            case 'j': bench.json_path = optarg; break;
+            case 'c': bench.csv_path = optarg; break;
+            case 'q': bench.quiet = true; break;
+            case 'b': bench.baseline_path = optarg; break;
+            case 't': bench.threshold = atof(optarg); break;
+            case 'u': bench.unit = optarg; break;
+            case 'p': bench.pin_cpu = atoi(optarg); break;
+            case 'i': bench.interleave = true; break;
+            case 'd': bench.detrend = true; break;
+            case 'R': bench.runs_path = optarg; break;
+            case 'r':
+                if (bench.num_refs >= BENCH_MAX_REFS) {
+                    fatal("too many reference lists", optarg);
+                }
+                bench.refs[bench.num_refs++] = optarg;
+                break;
+            case 'm':
+                if (!strchr(optarg, '=')) {
+                    fatal("metadata must be KEY=VALUE", optarg);
+                }
+                if (bench.num_meta >= BENCH_MAX_META) {
+                    fatal("too many metadata entries", optarg);
+                }
+                bench.meta[bench.num_meta++] = optarg;
+                break;
+            default: usage(); break;
+        }
+    }
+    const int num_args = argc - optind;
+    if ((num_args == 0) || (num_args & 1) || (bench.num_runs < 1) || (bench.num_warmup < 0)) {
+        usage();
+    }
+    bench.num_variants = num_args / 2;
+    bench.variants = (variant_t*) calloc(bench.num_variants, sizeof(variant_t));
+    for (int vi = 0; vi < bench.num_variants; vi++) {
+        variant_t* v = &bench.variants[vi];
+        v->name = argv[optind + vi*2];
+        v->cmd = argv[optind + vi*2 + 1];
+        v->runs = (run_t*) calloc(bench.num_runs, sizeof(run_t));
+        split_cmd(v);
+    }
+    assign_refs();
+    if (bench.unit && !find_variant(bench.unit)) {
+        fatal("unknown unit variant", bench.unit);
+    }
+    if (bench.pin_cpu >= 0) {
+        check_pin_cpu();
+    }
+    bench.start_ms = now_ms();
+    if (bench.interleave) {
+        /* one run of each variant per round, rotating the start variant */
+        if (!bench.quiet) {
+            fprintf(stderr, "=== interleaving %d variants over %d rounds\n", bench.num_variants, bench.num_warmup + bench.num_runs);
+        }
+        for (int round = 0; round < (bench.num_warmup + bench.num_runs); round++) {
+            for (int i = 0; i < bench.num_variants; i++) {
+                variant_t* v = &bench.variants[(round + i) % bench.num_variants];
+                const run_t run = run_once(v);
+                if (round >= bench.num_warmup) {
+                    v->runs[round - bench.num_warmup] = run;
+                }
+            }
+        }
+    }
+    else {
+        for (int vi = 0; vi < bench.num_variants; vi++) {
+            variant_t* v = &bench.variants[vi];
+            if (!bench.quiet) {
+                fprintf(stderr, "=== %s: %s\n", v->name, v->cmd);
+            }
+            for (int i = 0; i < bench.num_warmup; i++) {
+                run_once(v);
+            }
+            for (int i = 0; i < bench.num_runs; i++) {
+                v->runs[i] = run_once(v);
+            }
+        }
+    }
+    for (int vi = 0; vi < bench.num_variants; vi++) {
+        variant_t* v = &bench.variants[vi];
+        v->stats = compute_stats(v->runs, bench.num_runs);
+    }
+    for (int vi = 0; vi < bench.num_variants; vi++) {
+        bench.variants[vi].norm = compute_norm(&bench.variants[vi]);
+    }
+    if (!bench.quiet) {
+        print_table();
+    }
+    if (bench.json_path) {
+        write_json(bench.json_path);
+    }
+    if (bench.csv_path) {
+        write_csv(bench.csv_path);
+    }
+    if (bench.runs_path) {
+        write_runs(bench.runs_path);
+    }
+    if (bench.baseline_path) {
+        if (compare_baseline(bench.baseline_path) > 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,28 @@
+# shared definitions for the benchmark scripts, source with '. ./common.sh'
+
+# all headers in decl-orig.c include order
+HEADERS="beeper clk crt mem kbd
+    ay38910 i8255 m6502 m6522 m6526 m6569 m6581 mc6845 mc6847 z80 z80ctc z80pio
+    atom c64 cpc kc85 z1013 z9001 zx
+    sokol_app sokol_args sokol_audio sokol_gfx sokol_time"
+
+# the emulated systems
+SYSTEMS="atom c64 cpc kc85 z1013 z9001 zx"
+
+# headers which must be included before a system header
+deps() {
+    case $1 in
+        atom)  echo "m6502 mc6847 i8255 m6522 beeper mem kbd clk" ;;
+        c64)   echo "m6502 m6526 m6569 m6581 beeper kbd mem clk" ;;
+        cpc)   echo "z80 ay38910 i8255 mc6845 crt mem kbd clk" ;;
+        kc85)  echo "z80 z80ctc z80pio beeper kbd mem clk" ;;
+        z1013) echo "z80 z80pio mem kbd clk" ;;
+        z9001) echo "z80 z80pio z80ctc beeper mem kbd clk" ;;
+        zx)    echo "z80 beeper ay38910 mem kbd clk" ;;
+    esac
+}
+
+# print '#include "$DIR/X.h"' lines for a list of header names
+includes() {
+    for inc in "$@"; do echo "#include \"$DIR/$inc.h\""; done
+}
@@ -1,13 +1,10 @@
 #pragma once
 #include <stdint.h>
 #include <stdbool.h>
-
 #ifdef __cplusplus
 extern "C" {
 #endif
-
 #define BEEPER_FIXEDPOINT_SCALE (16)
-
 typedef struct {
     int state;
     int period;
@@ -15,13 +12,23 @@ typedef struct {
     float mag;
     float sample;
 } beeper_t;
-
 extern void beeper_init(beeper_t* beeper, int tick_hz, int sound_hz, float magnitude);
 extern void beeper_reset(beeper_t* beeper);
-extern void beeper_set(beeper_t* beeper, bool state);
-extern void beeper_toggle(beeper_t* beeper);
-extern bool beeper_tick(beeper_t* beeper);
-
+static inline void beeper_set(beeper_t* beeper, bool state) {
+    beeper->state = state ? 1 : 0;
+}
+static inline void beeper_toggle(beeper_t* beeper) {
+    beeper->state = !beeper->state;
+}
+static inline bool beeper_tick(beeper_t* beeper) {
+    beeper->counter -= BEEPER_FIXEDPOINT_SCALE;
+    if (beeper->counter <= 0) {
+        beeper->counter += beeper->period;
+        beeper->sample = ((float)beeper->state) * beeper->mag;
+        return true;
+    }
+    return false;
+}
 #ifdef __cplusplus
-} /* extern "C" */
-#endif
\ No newline at end of file
+}
+#endif
@@ -1,21 +1,17 @@
 #pragma once
 #include <stdint.h>
 #include <stdbool.h>
-
 #ifndef SOKOL_API_DECL
     #define SOKOL_API_DECL extern
 #endif
-
 #ifdef __cplusplus
 extern "C" {
 #endif
-
 enum {
     SAPP_MAX_TOUCHPOINTS = 8,
     SAPP_MAX_MOUSEBUTTONS = 3,
     SAPP_MAX_KEYCODES = 512,
 };
-
 typedef enum {
     SAPP_EVENTTYPE_INVALID,
     SAPP_EVENTTYPE_KEY_DOWN,
@@ -40,152 +36,147 @@ typedef enum {
     _SAPP_EVENTTYPE_NUM,
     _SAPP_EVENTTYPE_FORCE_U32 = 0x7FFFFFF
 } sapp_event_type;
-
 typedef enum {
-    SAPP_KEYCODE_INVALID          = 0,
-    SAPP_KEYCODE_SPACE            = 32,
-    SAPP_KEYCODE_APOSTROPHE       = 39,  /* ' */
-    SAPP_KEYCODE_COMMA            = 44,  /* , */
-    SAPP_KEYCODE_MINUS            = 45,  /* - */
-    SAPP_KEYCODE_PERIOD           = 46,  /* . */
-    SAPP_KEYCODE_SLASH            = 47,  /* / */
-    SAPP_KEYCODE_0                = 48,
-    SAPP_KEYCODE_1                = 49,
-    SAPP_KEYCODE_2                = 50,
-    SAPP_KEYCODE_3                = 51,
-    SAPP_KEYCODE_4                = 52,
-    SAPP_KEYCODE_5                = 53,
-    SAPP_KEYCODE_6                = 54,
-    SAPP_KEYCODE_7                = 55,
-    SAPP_KEYCODE_8                = 56,
-    SAPP_KEYCODE_9                = 57,
-    SAPP_KEYCODE_SEMICOLON        = 59,  /* ; */
-    SAPP_KEYCODE_EQUAL            = 61,  /* = */
-    SAPP_KEYCODE_A                = 65,
-    SAPP_KEYCODE_B                = 66,
-    SAPP_KEYCODE_C                = 67,
-    SAPP_KEYCODE_D                = 68,
-    SAPP_KEYCODE_E                = 69,
-    SAPP_KEYCODE_F                = 70,
-    SAPP_KEYCODE_G                = 71,
-    SAPP_KEYCODE_H                = 72,
-    SAPP_KEYCODE_I                = 73,
-    SAPP_KEYCODE_J                = 74,
-    SAPP_KEYCODE_K                = 75,
-    SAPP_KEYCODE_L                = 76,
-    SAPP_KEYCODE_M                = 77,
-    SAPP_KEYCODE_N                = 78,
-    SAPP_KEYCODE_O                = 79,
-    SAPP_KEYCODE_P                = 80,
-    SAPP_KEYCODE_Q                = 81,
-    SAPP_KEYCODE_R                = 82,
-    SAPP_KEYCODE_S                = 83,
-    SAPP_KEYCODE_T                = 84,
-    SAPP_KEYCODE_U                = 85,
-    SAPP_KEYCODE_V                = 86,
-    SAPP_KEYCODE_W                = 87,
-    SAPP_KEYCODE_X                = 88,
-    SAPP_KEYCODE_Y                = 89,
-    SAPP_KEYCODE_Z                = 90,
-    SAPP_KEYCODE_LEFT_BRACKET     = 91,  /* [ */
-    SAPP_KEYCODE_BACKSLASH        = 92,  /* \ */
-    SAPP_KEYCODE_RIGHT_BRACKET    = 93,  /* ] */
-    SAPP_KEYCODE_GRAVE_ACCENT     = 96,  /* ` */
-    SAPP_KEYCODE_WORLD_1          = 161, /* non-US #1 */
-    SAPP_KEYCODE_WORLD_2          = 162, /* non-US #2 */
-    SAPP_KEYCODE_ESCAPE           = 256,
-    SAPP_KEYCODE_ENTER            = 257,
-    SAPP_KEYCODE_TAB              = 258,
-    SAPP_KEYCODE_BACKSPACE        = 259,
-    SAPP_KEYCODE_INSERT           = 260,
-    SAPP_KEYCODE_DELETE           = 261,
-    SAPP_KEYCODE_RIGHT            = 262,
-    SAPP_KEYCODE_LEFT             = 263,
-    SAPP_KEYCODE_DOWN             = 264,
-    SAPP_KEYCODE_UP               = 265,
-    SAPP_KEYCODE_PAGE_UP          = 266,
-    SAPP_KEYCODE_PAGE_DOWN        = 267,
-    SAPP_KEYCODE_HOME             = 268,
-    SAPP_KEYCODE_END              = 269,
-    SAPP_KEYCODE_CAPS_LOCK        = 280,
-    SAPP_KEYCODE_SCROLL_LOCK      = 281,
-    SAPP_KEYCODE_NUM_LOCK         = 282,
-    SAPP_KEYCODE_PRINT_SCREEN     = 283,
-    SAPP_KEYCODE_PAUSE            = 284,
-    SAPP_KEYCODE_F1               = 290,
-    SAPP_KEYCODE_F2               = 291,
-    SAPP_KEYCODE_F3               = 292,
-    SAPP_KEYCODE_F4               = 293,
-    SAPP_KEYCODE_F5               = 294,
-    SAPP_KEYCODE_F6               = 295,
-    SAPP_KEYCODE_F7               = 296,
-    SAPP_KEYCODE_F8               = 297,
-    SAPP_KEYCODE_F9               = 298,
-    SAPP_KEYCODE_F10              = 299,
-    SAPP_KEYCODE_F11              = 300,
-    SAPP_KEYCODE_F12              = 301,
-    SAPP_KEYCODE_F13              = 302,
-    SAPP_KEYCODE_F14              = 303,
-    SAPP_KEYCODE_F15              = 304,
-    SAPP_KEYCODE_F16              = 305,
-    SAPP_KEYCODE_F17              = 306,
-    SAPP_KEYCODE_F18              = 307,
-    SAPP_KEYCODE_F19              = 308,
-    SAPP_KEYCODE_F20              = 309,
-    SAPP_KEYCODE_F21              = 310,
-    SAPP_KEYCODE_F22              = 311,
-    SAPP_KEYCODE_F23              = 312,
-    SAPP_KEYCODE_F24              = 313,
-    SAPP_KEYCODE_F25              = 314,
-    SAPP_KEYCODE_KP_0             = 320,
-    SAPP_KEYCODE_KP_1             = 321,
-    SAPP_KEYCODE_KP_2             = 322,
-    SAPP_KEYCODE_KP_3             = 323,
-    SAPP_KEYCODE_KP_4             = 324,
-    SAPP_KEYCODE_KP_5             = 325,
-    SAPP_KEYCODE_KP_6             = 326,
-    SAPP_KEYCODE_KP_7             = 327,
-    SAPP_KEYCODE_KP_8             = 328,
-    SAPP_KEYCODE_KP_9             = 329,
-    SAPP_KEYCODE_KP_DECIMAL       = 330,
-    SAPP_KEYCODE_KP_DIVIDE        = 331,
-    SAPP_KEYCODE_KP_MULTIPLY      = 332,
-    SAPP_KEYCODE_KP_SUBTRACT      = 333,
-    SAPP_KEYCODE_KP_ADD           = 334,
-    SAPP_KEYCODE_KP_ENTER         = 335,
-    SAPP_KEYCODE_KP_EQUAL         = 336,
-    SAPP_KEYCODE_LEFT_SHIFT       = 340,
-    SAPP_KEYCODE_LEFT_CONTROL     = 341,
-    SAPP_KEYCODE_LEFT_ALT         = 342,
-    SAPP_KEYCODE_LEFT_SUPER       = 343,
-    SAPP_KEYCODE_RIGHT_SHIFT      = 344,
-    SAPP_KEYCODE_RIGHT_CONTROL    = 345,
-    SAPP_KEYCODE_RIGHT_ALT        = 346,
-    SAPP_KEYCODE_RIGHT_SUPER      = 347,
-    SAPP_KEYCODE_MENU             = 348,
+    SAPP_KEYCODE_INVALID = 0,
+    SAPP_KEYCODE_SPACE = 32,
+    SAPP_KEYCODE_APOSTROPHE = 39,
+    SAPP_KEYCODE_COMMA = 44,
+    SAPP_KEYCODE_MINUS = 45,
+    SAPP_KEYCODE_PERIOD = 46,
+    SAPP_KEYCODE_SLASH = 47,
+    SAPP_KEYCODE_0 = 48,
+    SAPP_KEYCODE_1 = 49,
+    SAPP_KEYCODE_2 = 50,
+    SAPP_KEYCODE_3 = 51,
+    SAPP_KEYCODE_4 = 52,
+    SAPP_KEYCODE_5 = 53,
+    SAPP_KEYCODE_6 = 54,
+    SAPP_KEYCODE_7 = 55,
+    SAPP_KEYCODE_8 = 56,
+    SAPP_KEYCODE_9 = 57,
+    SAPP_KEYCODE_SEMICOLON = 59,
+    SAPP_KEYCODE_EQUAL = 61,
+    SAPP_KEYCODE_A = 65,
+    SAPP_KEYCODE_B = 66,
+    SAPP_KEYCODE_C = 67,
+    SAPP_KEYCODE_D = 68,
+    SAPP_KEYCODE_E = 69,
+    SAPP_KEYCODE_F = 70,
+    SAPP_KEYCODE_G = 71,
+    SAPP_KEYCODE_H = 72,
+    SAPP_KEYCODE_I = 73,
+    SAPP_KEYCODE_J = 74,
+    SAPP_KEYCODE_K = 75,
+    SAPP_KEYCODE_L = 76,
+    SAPP_KEYCODE_M = 77,
+    SAPP_KEYCODE_N = 78,
+    SAPP_KEYCODE_O = 79,
+    SAPP_KEYCODE_P = 80,
+    SAPP_KEYCODE_Q = 81,
+    SAPP_KEYCODE_R = 82,
+    SAPP_KEYCODE_S = 83,
+    SAPP_KEYCODE_T = 84,
+    SAPP_KEYCODE_U = 85,
+    SAPP_KEYCODE_V = 86,
+    SAPP_KEYCODE_W = 87,
+    SAPP_KEYCODE_X = 88,
+    SAPP_KEYCODE_Y = 89,
+    SAPP_KEYCODE_Z = 90,
+    SAPP_KEYCODE_LEFT_BRACKET = 91,
+    SAPP_KEYCODE_BACKSLASH = 92,
+    SAPP_KEYCODE_RIGHT_BRACKET = 93,
+    SAPP_KEYCODE_GRAVE_ACCENT = 96,
+    SAPP_KEYCODE_WORLD_1 = 161,
+    SAPP_KEYCODE_WORLD_2 = 162,
+    SAPP_KEYCODE_ESCAPE = 256,
+    SAPP_KEYCODE_ENTER = 257,
+    SAPP_KEYCODE_TAB = 258,
+    SAPP_KEYCODE_BACKSPACE = 259,
+    SAPP_KEYCODE_INSERT = 260,
+    SAPP_KEYCODE_DELETE = 261,
+    SAPP_KEYCODE_RIGHT = 262,
+    SAPP_KEYCODE_LEFT = 263,
+    SAPP_KEYCODE_DOWN = 264,
+    SAPP_KEYCODE_UP = 265,
+    SAPP_KEYCODE_PAGE_UP = 266,
+    SAPP_KEYCODE_PAGE_DOWN = 267,
+    SAPP_KEYCODE_HOME = 268,
+    SAPP_KEYCODE_END = 269,
+    SAPP_KEYCODE_CAPS_LOCK = 280,
+    SAPP_KEYCODE_SCROLL_LOCK = 281,
+    SAPP_KEYCODE_NUM_LOCK = 282,
+    SAPP_KEYCODE_PRINT_SCREEN = 283,
+    SAPP_KEYCODE_PAUSE = 284,
+    SAPP_KEYCODE_F1 = 290,
+    SAPP_KEYCODE_F2 = 291,
+    SAPP_KEYCODE_F3 = 292,
+    SAPP_KEYCODE_F4 = 293,
+    SAPP_KEYCODE_F5 = 294,
+    SAPP_KEYCODE_F6 = 295,
+    SAPP_KEYCODE_F7 = 296,
+    SAPP_KEYCODE_F8 = 297,
+    SAPP_KEYCODE_F9 = 298,
+    SAPP_KEYCODE_F10 = 299,
+    SAPP_KEYCODE_F11 = 300,
+    SAPP_KEYCODE_F12 = 301,
+    SAPP_KEYCODE_F13 = 302,
+    SAPP_KEYCODE_F14 = 303,
+    SAPP_KEYCODE_F15 = 304,
+    SAPP_KEYCODE_F16 = 305,
+    SAPP_KEYCODE_F17 = 306,
+    SAPP_KEYCODE_F18 = 307,
+    SAPP_KEYCODE_F19 = 308,
+    SAPP_KEYCODE_F20 = 309,
+    SAPP_KEYCODE_F21 = 310,
+    SAPP_KEYCODE_F22 = 311,
+    SAPP_KEYCODE_F23 = 312,
+    SAPP_KEYCODE_F24 = 313,
+    SAPP_KEYCODE_F25 = 314,
+    SAPP_KEYCODE_KP_0 = 320,
+    SAPP_KEYCODE_KP_1 = 321,
+    SAPP_KEYCODE_KP_2 = 322,
+    SAPP_KEYCODE_KP_3 = 323,
+    SAPP_KEYCODE_KP_4 = 324,
+    SAPP_KEYCODE_KP_5 = 325,
+    SAPP_KEYCODE_KP_6 = 326,
+    SAPP_KEYCODE_KP_7 = 327,
+    SAPP_KEYCODE_KP_8 = 328,
+    SAPP_KEYCODE_KP_9 = 329,
+    SAPP_KEYCODE_KP_DECIMAL = 330,
+    SAPP_KEYCODE_KP_DIVIDE = 331,
+    SAPP_KEYCODE_KP_MULTIPLY = 332,
+    SAPP_KEYCODE_KP_SUBTRACT = 333,
+    SAPP_KEYCODE_KP_ADD = 334,
+    SAPP_KEYCODE_KP_ENTER = 335,
+    SAPP_KEYCODE_KP_EQUAL = 336,
+    SAPP_KEYCODE_LEFT_SHIFT = 340,
+    SAPP_KEYCODE_LEFT_CONTROL = 341,
+    SAPP_KEYCODE_LEFT_ALT = 342,
+    SAPP_KEYCODE_LEFT_SUPER = 343,
+    SAPP_KEYCODE_RIGHT_SHIFT = 344,
+    SAPP_KEYCODE_RIGHT_CONTROL = 345,
+    SAPP_KEYCODE_RIGHT_ALT = 346,
+    SAPP_KEYCODE_RIGHT_SUPER = 347,
+    SAPP_KEYCODE_MENU = 348,
 } sapp_keycode;
-
 typedef struct {
     uintptr_t identifier;
     float pos_x;
     float pos_y;
     bool changed;
 } sapp_touchpoint;
-
 typedef enum {
     SAPP_MOUSEBUTTON_INVALID = -1,
     SAPP_MOUSEBUTTON_LEFT = 0,
     SAPP_MOUSEBUTTON_RIGHT = 1,
     SAPP_MOUSEBUTTON_MIDDLE = 2,
 } sapp_mousebutton;
-
 enum {
     SAPP_MODIFIER_SHIFT = (1<<0),
     SAPP_MODIFIER_CTRL = (1<<1),
     SAPP_MODIFIER_ALT = (1<<2),
     SAPP_MODIFIER_SUPER = (1<<3)
 };
-
 typedef struct {
     sapp_event_type type;
     uint32_t frame_count;
@@ -204,7 +195,6 @@ typedef struct {
     int framebuffer_width;
     int framebuffer_height;
 } sapp_event;
-
 typedef struct {
     void (*init_cb)(void);
     void (*frame_cb)(void);
@@ -224,12 +214,10 @@ typedef struct {
     const char* html5_canvas_name;
     bool html5_canvas_resize;
     bool ios_keyboard_resizes_canvas;
-    bool gl_force_gles2; 
+    bool gl_force_gles2;
     bool user_cursor;
 } sapp_desc;
-
 extern sapp_desc sokol_main(int argc, char* argv[]);
-
 SOKOL_API_DECL bool sapp_isvalid(void);
 SOKOL_API_DECL int sapp_width(void);
 SOKOL_API_DECL int sapp_height(void);
@@ -240,7 +228,7 @@ SOKOL_API_DECL bool sapp_keyboard_shown(void);
 SOKOL_API_DECL bool sapp_gles2(void);
 SOKOL_API_DECL const void* sapp_metal_get_device(void);
 SOKOL_API_DECL const void* sapp_metal_get_renderpass_descriptor(void);
-SOKOL_API_DECL const void* sapp_metal_get_drawable(void); 
+SOKOL_API_DECL const void* sapp_metal_get_drawable(void);
 SOKOL_API_DECL const void* sapp_macos_get_window(void);
 SOKOL_API_DECL const void* sapp_ios_get_window(void);
 SOKOL_API_DECL const void* sapp_d3d11_get_device(void);
@@ -248,7 +236,6 @@ SOKOL_API_DECL const void* sapp_d3d11_get_device_context(void);
 SOKOL_API_DECL const void* sapp_d3d11_get_render_target_view(void);
 SOKOL_API_DECL const void* sapp_d3d11_get_depth_stencil_view(void);
 SOKOL_API_DECL const void* sapp_win32_get_hwnd(void);
-
 #ifdef __cplusplus
-} /* extern "C" */
+}
 #endif
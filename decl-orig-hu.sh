@@ -0,0 +1,59 @@
+# C++20 header-unit variant of decl-orig.sh
+#
+# Compiles the orig/ headers (the includes of decl-orig.c) into a single
+# C++20 header unit with g++ and clang++ (if installed) and compiles a TU
+# which imports it. The individual system headers (zx.h, c64.h, ...) can't
+# be separate header units because they depend on types from the chip
+# headers included before them. Reports the time to build the header unit,
+# the per-TU time of textual inclusion vs import (both in C++20 mode) and
+# the size of the compiled header unit. Results go to decl-orig-hu.csv.
+#
+#   RUNS=100    timed runs per variant
+RUNS=${RUNS:-100}
+OUT=_hu
+cc -O2 -o bench bench.c -lm || exit 1
+rm -rf $OUT gcm.cache && mkdir -p $OUT
+
+cp decl-orig.c $OUT/all.h
+echo '#include "all.h"' > $OUT/include.cc
+echo 'import "all.h";' > $OUT/import.cc
+set --
+for comp in g++ clang++; do
+    command -v $comp > /dev/null || continue
+    case $comp in
+        g++)
+            # g++ writes the compiled header unit to gcm.cache/ in the current directory
+            BMI=gcm.cache/,/$OUT/all.h.gcm
+            BUILD="g++ -std=c++20 -fmodules-ts -I. -x c++-user-header $OUT/all.h"
+            USE="g++ -std=c++20 -fmodules-ts -I. -c $OUT/import.cc -o $OUT/import-gcc.o"
+            INCL="g++ -std=c++20 -I. -I$OUT -c $OUT/include.cc -o $OUT/include-gcc.o"
+            NAME=gcc
+            ;;
+        clang++)
+            BMI=$OUT/all.pcm
+            BUILD="clang++ -std=c++20 -I. -fmodule-header=user -x c++-header $OUT/all.h -o $BMI"
+            USE="clang++ -std=c++20 -I. -I$OUT -fmodule-file=$BMI -c $OUT/import.cc -o $OUT/import-clang.o"
+            INCL="clang++ -std=c++20 -I. -I$OUT -c $OUT/include.cc -o $OUT/include-clang.o"
+            NAME=clang
+            ;;
+    esac
+    $BUILD || exit 1
+    echo "$comp: header unit size $(wc -c < $BMI) bytes"
+    set -- "$@" \
+        $NAME-hu-build  "$BUILD" \
+        $NAME-tu-include "$INCL" \
+        $NAME-tu-import  "$USE"
+done
+./bench -w 3 -n $RUNS -c decl-orig-hu.csv "$@" || exit 1
+
+# break-even: number of TUs after which the header unit build is amortized
+awk -F, 'NR > 1 { t[$1] = $4 }
+    END {
+        for (comp in t) {
+            if (comp !~ /-hu-build$/) continue
+            c = comp; sub(/-hu-build$/, "", c)
+            saved = t[c "-tu-include"] - t[c "-tu-import"]
+            if (saved > 0) printf "%s: import saves %.2f ms per TU, pays off after %.1f TUs\n", c, saved, t[comp] / saved
+            else printf "%s: import does not save time per TU\n", c
+        }
+    }' decl-orig-hu.csv
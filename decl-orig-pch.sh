@@ -0,0 +1,54 @@
+# precompiled header variant of decl-orig.sh
+#
+# Builds a PCH of all orig/ headers (the includes of decl-orig.c) with gcc
+# and clang (if installed), and compiles a TU against it. Reports the time
+# to build the PCH, the per-TU time with and without the PCH, the PCH size
+# on disk, and after how many TUs building the PCH pays off.
+# Results go to decl-orig-pch.csv.
+#
+#   RUNS=100    timed runs per variant
+RUNS=${RUNS:-100}
+OUT=_pch
+cc -O2 -o bench bench.c -lm || exit 1
+rm -rf $OUT && mkdir -p $OUT
+
+set --
+for comp in gcc clang; do
+    command -v $comp > /dev/null || continue
+    mkdir -p $OUT/$comp
+    cp decl-orig.c $OUT/$comp/all.h
+    echo '#include "all.h"' > $OUT/$comp/tu.c
+    case $comp in
+        gcc)
+            # gcc picks up all.h.gch automatically when it sits next to all.h
+            PCH=$OUT/gcc/all.h.gch
+            BUILD="gcc -I. -x c-header $OUT/gcc/all.h -o $PCH"
+            USE="gcc -I. -I$OUT/gcc -Winvalid-pch -c $OUT/gcc/tu.c -o $OUT/gcc/tu.o"
+            ;;
+        clang)
+            PCH=$OUT/clang/all.h.pch
+            BUILD="clang -I. -x c-header $OUT/clang/all.h -o $PCH"
+            USE="clang -I. -include-pch $PCH -c $OUT/clang/tu.c -o $OUT/clang/tu.o"
+            ;;
+    esac
+    # build once up front so the TU variants find the PCH
+    $BUILD || exit 1
+    echo "$comp: PCH size $(wc -c < $PCH) bytes"
+    set -- "$@" \
+        $comp-pch-build "$BUILD" \
+        $comp-tu-nopch  "$comp -c decl-orig.c -o $OUT/$comp/decl-orig.o" \
+        $comp-tu-pch    "$USE"
+done
+./bench -w 3 -n $RUNS -c decl-orig-pch.csv "$@" || exit 1
+
+# break-even: number of TUs after which the PCH build is amortized
+awk -F, 'NR > 1 { t[$1] = $4 }
+    END {
+        for (comp in t) {
+            if (comp !~ /-pch-build$/) continue
+            c = comp; sub(/-pch-build$/, "", c)
+            saved = t[c "-tu-nopch"] - t[c "-tu-pch"]
+            if (saved > 0) printf "%s: PCH saves %.2f ms per TU, pays off after %.1f TUs\n", c, saved, t[comp] / saved
+            else printf "%s: PCH does not save time per TU\n", c
+        }
+    }' decl-orig-pch.csv
@@ -67,4 +67,4 @@ static inline bool beeper_tick(beeper_t* beeper) {
 
 #ifdef __cplusplus
 } /* extern "C" */
-#endif
\ No newline at end of file
+#endif
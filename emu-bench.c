@@ -0,0 +1,692 @@
+/*
+    emu-bench.c -- headless emulator throughput benchmark
+
+    Instantiates each emulated system from impl/ with synthetic ROM images
+    (generated here, no real ROM dumps needed) and drives its *_exec()
+    function in 20ms slices (one PAL video frame, like a frontend would)
+    for a fixed number of emulated seconds. The CPU runs a small loop in
+    ROM (block copy, ALU ops, subroutine calls, indexed and prefixed
+    instructions on the Z80) with interrupts disabled, so all time goes
+    into the CPU and the per-tick work of the system (video, audio, timers).
+
+    With -i N, N independent instances of each system run interleaved
+    frame by frame on the one host thread, like a batch farm packing
+    several emulator instances onto one core. The numbers are then the
+    throughput of all instances together (except for realtime).
+
+    Reports per system:
+        emu MHz         emulated CPU ticks per host second
+        ns/tick         host nanoseconds per emulated tick
+        frames/s        emulated 20ms frames per host second
+        realtime        how many times faster than the real machine (per instance)
+
+    Each result line also records the compiler (__VERSION__), the compile
+    flags (passed in as EMU_BENCH_CFLAGS) and the host CPU model, so a
+    stored baseline is only compared against runs of the same setup.
+
+    Build:
+        cc -O2 -DEMU_BENCH_CFLAGS='"-O2"' -o emu-bench emu-bench.c -lm
+
+    Usage:
+        ./emu-bench [options] [system ...]
+
+    Options:
+        -s N        emulated seconds per timed run (default: 10)
+        -n N        number of timed runs per system (default: 5)
+        -w N        untimed warmup in emulated seconds (default: 1)
+        -c FILE     write CSV results to FILE (one line per system)
+        -b FILE     compare ns/tick against a baseline CSV written with
+                    -c, exit with status 1 if any system got slower
+        -t PCT      regression threshold in percent for -b (default: 5)
+        -i N        number of instances per system (default: 1, max: 16)
+        -q          don't print the result table to stdout
+
+    Systems: zx c64 cpc kc85 atom z1013 z9001 (default: all)
+*/
+#define _GNU_SOURCE
+#define CHIPS_IMPL
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "impl/beeper.h"
+#include "impl/clk.h"
+#include "impl/crt.h"
+#include "impl/mem.h"
+#include "impl/kbd.h"
+#include "impl/resampler.h"
+
+#include "impl/ay38910.h"
+#include "impl/i8255.h"
+#include "impl/m6502.h"
+#include "impl/m6522.h"
+#include "impl/m6526.h"
+#include "impl/m6569.h"
+#include "impl/m6581.h"
+#include "impl/mc6845.h"
+#include "impl/mc6847.h"
+#include "impl/z80.h"
+#include "impl/z80ctc.h"
+#include "impl/z80pio.h"
+
+#include "impl/atom.h"
+#include "impl/c64.h"
+#include "impl/cpc.h"
+#include "impl/kc85.h"
+#include "impl/z1013.h"
+#include "impl/z9001.h"
+#include "impl/zx.h"
+
+#ifndef EMU_BENCH_CFLAGS
+#define EMU_BENCH_CFLAGS "unknown"
+#endif
+
+#define EMU_MAX_RUNS (1000)
+#define EMU_MAX_INSTANCES (16)
+#define EMU_FRAME_US (20000)
+#define EMU_PIXEL_BUFFER_SIZE (1024*312*4)
+
+typedef struct {
+    const char* name;
+    void (*init)(int inst);
+    void (*exec)(int inst, uint32_t micro_seconds);
+    clk_t* (*clk)(int inst);
+} emu_system_t;
+
+typedef struct {
+    double host_ms[EMU_MAX_RUNS];
+    double median_ms;
+    double min_ms;
+    int64_t ticks;
+    int frames;
+} emu_result_t;
+
+static struct {
+    int num_runs;
+    int num_instances;
+    int seconds;
+    int warmup_seconds;
+    const char* csv_path;
+    const char* baseline_path;
+    double threshold;
+    bool quiet;
+    char cpu[128];
+    int64_t ticks;
+    float audio_sum;
+} emu = {
+    .num_runs = 5,
+    .num_instances = 1,
+    .seconds = 10,
+    .warmup_seconds = 1,
+    .threshold = 5.0,
+};
+
+static uint32_t pixel_buffer[EMU_PIXEL_BUFFER_SIZE / 4];
+static float audio_kernel_buffer[RESAMPLER_MAX_KERNEL_SIZE / sizeof(float)];
+
+static void fatal(const char* msg) {
+    fprintf(stderr, "emu-bench: %s\n", msg);
+    exit(2);
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: emu-bench [-s secs] [-n runs] [-w secs] [-c csv] [-b baseline.csv] [-t pct] [-i instances] [-q] [system ...]\n");
+    exit(2);
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/* consume the generated audio so it can't be optimized away */
+static void audio_cb(const float* samples, int num_samples, void* user_data) {
+    (void)user_data;
+    for (int i = 0; i < num_samples; i++) {
+        emu.audio_sum += samples[i];
+    }
+}
+
+/*=== SYNTHETIC ROMS =========================================================*/
+/*
+    Z80 loop at org, using RAM at work..work+0x1FF:
+
+        DI
+        LD SP,work+0x200
+    loop:
+        LD HL,work
+        LD DE,work+0x100
+        LD BC,0x0040
+        LDIR
+        LD B,0x20
+    inner:
+        LD A,(HL)
+        ADD A,(HL)
+        XOR 0x5A
+        RRC A
+        LD (HL),A
+        INC HL
+        CALL sub
+        DJNZ inner
+        LD IX,work
+        LD A,(IX+5)
+        LD IY,work+0x100
+        LD (IY+7),A
+        RLC (IX+3)
+        JP loop
+    sub:
+        PUSH HL
+        LD HL,(work+0x80)
+        ADD HL,DE
+        LD (work+0x80),HL
+        POP HL
+        RET
+*/
+static void gen_z80_rom(uint8_t* rom, int rom_size, int offset, uint16_t org, uint16_t work) {
+    memset(rom, 0, rom_size);
+    #define W(a) (uint8_t)((a)&0xFF), (uint8_t)((a)>>8)
+    const uint16_t loop = org + 4;
+    const uint16_t sub = org + 51;
+    const uint8_t code[] = {
+        0xF3,
+        0x31, W(work+0x200),
+        0x21, W(work),
+        0x11, W(work+0x100),
+        0x01, W(0x0040),
+        0xED, 0xB0,
+        0x06, 0x20,
+        0x7E,
+        0x86,
+        0xEE, 0x5A,
+        0xCB, 0x0F,
+        0x77,
+        0x23,
+        0xCD, W(sub),
+        0x10, 0xF3,
+        0xDD, 0x21, W(work),
+        0xDD, 0x7E, 0x05,
+        0xFD, 0x21, W(work+0x100),
+        0xFD, 0x77, 0x07,
+        0xDD, 0xCB, 0x03, 0x06,
+        0xC3, W(loop),
+        0xE5,
+        0x2A, W(work+0x80),
+        0x19,
+        0x22, W(work+0x80),
+        0xE1,
+        0xC9,
+    };
+    #undef W
+    CHIPS_ASSERT(sizeof(code) == 61);
+    CHIPS_ASSERT((offset + (int)sizeof(code)) <= rom_size);
+    memcpy(rom + offset, code, sizeof(code));
+}
+
+/*
+    6502 loop at org, using RAM at work..work+0x1FF, the vectors at
+    0xFFFA..0xFFFF are written to vec_offset in the ROM:
+
+        SEI
+        CLD
+        LDX #$FF
+        TXS
+    loop:
+        LDY #0
+    copy:
+        LDA work,Y
+        STA work+$100,Y
+        INY
+        CPY #$40
+        BNE copy
+        LDX #$20
+    inner:
+        LDA work,X
+        ADC work+$100,X
+        EOR #$5A
+        ROR A
+        STA work,X
+        JSR sub
+        DEX
+        BNE inner
+        INC work+$80
+        JMP loop
+    sub:
+        PHA
+        CLC
+        LDA work+$81
+        ADC #3
+        STA work+$81
+        PLA
+        RTS
+    irq:
+        RTI
+*/
+static void gen_m6502_rom(uint8_t* rom, int rom_size, int offset, int vec_offset, uint16_t org, uint16_t work) {
+    memset(rom, 0, rom_size);
+    #define W(a) (uint8_t)((a)&0xFF), (uint8_t)((a)>>8)
+    const uint16_t loop = org + 5;
+    const uint16_t sub = org + 44;
+    const uint16_t irq = org + 56;
+    const uint8_t code[] = {
+        0x78,
+        0xD8,
+        0xA2, 0xFF,
+        0x9A,
+        0xA0, 0x00,
+        0xB9, W(work),
+        0x99, W(work+0x100),
+        0xC8,
+        0xC0, 0x40,
+        0xD0, 0xF5,
+        0xA2, 0x20,
+        0xBD, W(work),
+        0x7D, W(work+0x100),
+        0x49, 0x5A,
+        0x6A,
+        0x9D, W(work),
+        0x20, W(sub),
+        0xCA,
+        0xD0, 0xEE,
+        0xEE, W(work+0x80),
+        0x4C, W(loop),
+        0x48,
+        0x18,
+        0xAD, W(work+0x81),
+        0x69, 0x03,
+        0x8D, W(work+0x81),
+        0x68,
+        0x60,
+        0x40,
+    };
+    const uint8_t vectors[] = { W(irq), W(org), W(irq) };
+    #undef W
+    CHIPS_ASSERT(sizeof(code) == 57);
+    CHIPS_ASSERT((offset + (int)sizeof(code)) <= rom_size);
+    CHIPS_ASSERT((vec_offset + (int)sizeof(vectors)) <= rom_size);
+    memcpy(rom + offset, code, sizeof(code));
+    memcpy(rom + vec_offset, vectors, sizeof(vectors));
+}
+
+/*=== SYSTEMS ================================================================*/
+static uint8_t rom_a[0x4000];
+static uint8_t rom_b[0x4000];
+static uint8_t rom_c[0x4000];
+
+static zx_t zx[EMU_MAX_INSTANCES];
+static void zx_bench_init(int inst) {
+    gen_z80_rom(rom_a, 0x4000, 0x0000, 0x0000, 0x8000);
+    zx_desc_t desc = {
+        .type = ZX_TYPE_48K,
+        .pixel_buffer = pixel_buffer,
+        .pixel_buffer_size = sizeof(pixel_buffer),
+        .audio_cb = audio_cb,
+        .rom_zx48k = rom_a,
+        .rom_zx48k_size = 0x4000,
+    };
+    zx_init(&zx[inst], &desc);
+}
+static void zx_bench_exec(int inst, uint32_t us) { zx_exec(&zx[inst], us); }
+static clk_t* zx_bench_clk(int inst) { return &zx[inst].clk; }
+
+static c64_t c64[EMU_MAX_INSTANCES];
+static void c64_bench_init(int inst) {
+    /* kernal ROM at 0xE000 */
+    gen_m6502_rom(rom_a, 0x2000, 0x0000, 0x1FFA, 0xE000, 0x2000);
+    memset(rom_b, 0, sizeof(rom_b));
+    memset(rom_c, 0, sizeof(rom_c));
+    c64_desc_t desc = {
+        .pixel_buffer = pixel_buffer,
+        .pixel_buffer_size = sizeof(pixel_buffer),
+        .audio_cb = audio_cb,
+        .rom_char = rom_c,
+        .rom_char_size = 0x1000,
+        .rom_basic = rom_b,
+        .rom_basic_size = 0x2000,
+        .rom_kernal = rom_a,
+        .rom_kernal_size = 0x2000,
+    };
+    c64_init(&c64[inst], &desc);
+}
+static void c64_bench_exec(int inst, uint32_t us) { c64_exec(&c64[inst], us); }
+static clk_t* c64_bench_clk(int inst) { return &c64[inst].clk; }
+
+static cpc_t cpc[EMU_MAX_INSTANCES];
+static void cpc_bench_init(int inst) {
+    /* lower (OS) ROM at 0x0000 */
+    gen_z80_rom(rom_a, 0x4000, 0x0000, 0x0000, 0x8000);
+    memset(rom_b, 0, sizeof(rom_b));
+    memset(rom_c, 0, sizeof(rom_c));
+    cpc_desc_t desc = {
+        .type = CPC_TYPE_6128,
+        .pixel_buffer = pixel_buffer,
+        .pixel_buffer_size = sizeof(pixel_buffer),
+        .audio_cb = audio_cb,
+        .audio_kernel_buffer = audio_kernel_buffer,
+        .audio_kernel_buffer_size = sizeof(audio_kernel_buffer),
+        .rom_6128_os = rom_a,
+        .rom_6128_os_size = 0x4000,
+        .rom_6128_basic = rom_b,
+        .rom_6128_basic_size = 0x4000,
+        .rom_6128_amsdos = rom_c,
+        .rom_6128_amsdos_size = 0x4000,
+    };
+    cpc_init(&cpc[inst], &desc);
+}
+static void cpc_bench_exec(int inst, uint32_t us) { cpc_exec(&cpc[inst], us); }
+static clk_t* cpc_bench_clk(int inst) { return &cpc[inst].clk; }
+
+static kc85_t kc85[EMU_MAX_INSTANCES];
+static void kc85_bench_init(int inst) {
+    /* KC85/2 CAOS ROM at 0xE000, execution starts at 0xF000 */
+    gen_z80_rom(rom_a, 0x2000, 0x1000, 0xF000, 0x2000);
+    kc85_desc_t desc = {
+        .type = KC85_TYPE_2,
+        .pixel_buffer = pixel_buffer,
+        .pixel_buffer_size = sizeof(pixel_buffer),
+        .audio_cb = audio_cb,
+        .rom_caos22 = rom_a,
+        .rom_caos22_size = 0x2000,
+    };
+    kc85_init(&kc85[inst], &desc);
+}
+static void kc85_bench_exec(int inst, uint32_t us) { kc85_exec(&kc85[inst], us); }
+static clk_t* kc85_bench_clk(int inst) { return &kc85[inst].clk; }
+
+static atom_t atom[EMU_MAX_INSTANCES];
+static void atom_bench_init(int inst) {
+    /* the upper 4 KB of the BASIC ROM are mapped at 0xF000 */
+    gen_m6502_rom(rom_a, 0x2000, 0x1000, 0x1FFA, 0xF000, 0x2000);
+    memset(rom_b, 0, sizeof(rom_b));
+    memset(rom_c, 0, sizeof(rom_c));
+    atom_desc_t desc = {
+        .pixel_buffer = pixel_buffer,
+        .pixel_buffer_size = sizeof(pixel_buffer),
+        .audio_cb = audio_cb,
+        .rom_abasic = rom_a,
+        .rom_abasic_size = 0x2000,
+        .rom_afloat = rom_b,
+        .rom_afloat_size = 0x1000,
+        .rom_dosrom = rom_c,
+        .rom_dosrom_size = 0x1000,
+    };
+    atom_init(&atom[inst], &desc);
+}
+static void atom_bench_exec(int inst, uint32_t us) { atom_exec(&atom[inst], us); }
+static clk_t* atom_bench_clk(int inst) { return &atom[inst].clk; }
+
+static z1013_t z1013[EMU_MAX_INSTANCES];
+static void z1013_bench_init(int inst) {
+    /* monitor ROM at 0xF000 */
+    gen_z80_rom(rom_a, 0x0800, 0x0000, 0xF000, 0x2000);
+    memset(rom_b, 0, sizeof(rom_b));
+    z1013_desc_t desc = {
+        .type = Z1013_TYPE_64,
+        .pixel_buffer = pixel_buffer,
+        .pixel_buffer_size = sizeof(pixel_buffer),
+        .rom_mon_a2 = rom_a,
+        .rom_mon_a2_size = 0x0800,
+        .rom_font = rom_b,
+        .rom_font_size = 0x0800,
+    };
+    z1013_init(&z1013[inst], &desc);
+}
+static void z1013_bench_exec(int inst, uint32_t us) { z1013_exec(&z1013[inst], us); }
+static clk_t* z1013_bench_clk(int inst) { return &z1013[inst].clk; }
+
+static z9001_t z9001[EMU_MAX_INSTANCES];
+static void z9001_bench_init(int inst) {
+    /* OS ROM 1 at 0xF000 */
+    gen_z80_rom(rom_a, 0x0800, 0x0000, 0xF000, 0x2000);
+    memset(rom_b, 0, sizeof(rom_b));
+    memset(rom_c, 0, sizeof(rom_c));
+    z9001_desc_t desc = {
+        .type = Z9001_TYPE_Z9001,
+        .pixel_buffer = pixel_buffer,
+        .pixel_buffer_size = sizeof(pixel_buffer),
+        .audio_cb = audio_cb,
+        .rom_z9001_os_1 = rom_a,
+        .rom_z9001_os_1_size = 0x0800,
+        .rom_z9001_os_2 = rom_b,
+        .rom_z9001_os_2_size = 0x0800,
+        .rom_z9001_font = rom_c,
+        .rom_z9001_font_size = 0x0800,
+    };
+    z9001_init(&z9001[inst], &desc);
+}
+static void z9001_bench_exec(int inst, uint32_t us) { z9001_exec(&z9001[inst], us); }
+static clk_t* z9001_bench_clk(int inst) { return &z9001[inst].clk; }
+
+static const emu_system_t systems[] = {
+    { "zx",    zx_bench_init,    zx_bench_exec,    zx_bench_clk },
+    { "c64",   c64_bench_init,   c64_bench_exec,   c64_bench_clk },
+    { "cpc",   cpc_bench_init,   cpc_bench_exec,   cpc_bench_clk },
+    { "kc85",  kc85_bench_init,  kc85_bench_exec,  kc85_bench_clk },
+    { "atom",  atom_bench_init,  atom_bench_exec,  atom_bench_clk },
+    { "z1013", z1013_bench_init, z1013_bench_exec, z1013_bench_clk },
+    { "z9001", z9001_bench_init, z9001_bench_exec, z9001_bench_clk },
+};
+#define EMU_NUM_SYSTEMS ((int)(sizeof(systems) / sizeof(systems[0])))
+
+/*=== BENCHMARK ==============================================================*/
+/* run all instances of the system for a number of 20ms frames, returns the executed ticks */
+static int64_t run_frames(const emu_system_t* sys, int frames) {
+    int64_t ticks = 0;
+    for (int i = 0; i < frames; i++) {
+        for (int inst = 0; inst < emu.num_instances; inst++) {
+            sys->exec(inst, EMU_FRAME_US);
+            /* clk_ticks_executed() only keeps the overrun */
+            const clk_t* clk = sys->clk(inst);
+            ticks += clk->ticks_to_run + clk->overrun_ticks;
+        }
+    }
+    return ticks;
+}
+
+static int cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x < y) ? -1 : (x > y);
+}
+
+static void bench_system(const emu_system_t* sys, emu_result_t* res) {
+    const int frames = emu.seconds * (1000000 / EMU_FRAME_US);
+    for (int inst = 0; inst < emu.num_instances; inst++) {
+        sys->init(inst);
+    }
+    run_frames(sys, emu.warmup_seconds * (1000000 / EMU_FRAME_US));
+    memset(res, 0, sizeof(emu_result_t));
+    for (int run = 0; run < emu.num_runs; run++) {
+        double t0 = now_ms();
+        res->ticks = run_frames(sys, frames);
+        res->host_ms[run] = now_ms() - t0;
+    }
+    res->frames = frames;
+    double sorted[EMU_MAX_RUNS];
+    memcpy(sorted, res->host_ms, emu.num_runs * sizeof(double));
+    qsort(sorted, emu.num_runs, sizeof(double), cmp_double);
+    res->min_ms = sorted[0];
+    if (emu.num_runs & 1) {
+        res->median_ms = sorted[emu.num_runs / 2];
+    }
+    else {
+        res->median_ms = 0.5 * (sorted[emu.num_runs / 2 - 1] + sorted[emu.num_runs / 2]);
+    }
+}
+
+static double emu_mhz(const emu_result_t* res) {
+    return res->ticks / (res->median_ms * 1000.0);
+}
+
+static double ns_per_tick(const emu_result_t* res) {
+    return (res->median_ms * 1000000.0) / res->ticks;
+}
+
+static double frames_per_sec(const emu_result_t* res) {
+    return res->frames * emu.num_instances / (res->median_ms / 1000.0);
+}
+
+static double realtime(const emu_result_t* res) {
+    return (emu.seconds * 1000.0) / res->median_ms;
+}
+
+/* host CPU model from /proc/cpuinfo, commas replaced to keep the CSV simple */
+static void read_cpu_model(void) {
+    snprintf(emu.cpu, sizeof(emu.cpu), "unknown");
+    FILE* fp = fopen("/proc/cpuinfo", "r");
+    if (!fp) {
+        return;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+        if (0 == strncmp(line, "model name", 10)) {
+            const char* p = strchr(line, ':');
+            if (p) {
+                p++;
+                while (*p == ' ') p++;
+                snprintf(emu.cpu, sizeof(emu.cpu), "%s", p);
+                emu.cpu[strcspn(emu.cpu, "\n")] = 0;
+            }
+            break;
+        }
+    }
+    fclose(fp);
+    for (char* p = emu.cpu; *p; p++) {
+        if (*p == ',') *p = ';';
+    }
+}
+
+static void write_csv(const emu_system_t** sel, const emu_result_t* res, int num) {
+    FILE* fp = fopen(emu.csv_path, "w");
+    if (!fp) {
+        fatal("failed to open CSV file");
+    }
+    fprintf(fp, "system,runs,emu_seconds,freq_mhz,median_ms,min_ms,emu_mhz,ns_per_tick,frames_per_sec,realtime,compiler,cflags,cpu,instances\n");
+    for (int i = 0; i < num; i++) {
+        fprintf(fp, "%s,%d,%d,%.6f,%.3f,%.3f,%.3f,%.3f,%.1f,%.2f,%s,%s,%s,%d\n",
+            sel[i]->name, emu.num_runs, emu.seconds, sel[i]->clk(0)->freq_hz / 1000000.0,
+            res[i].median_ms, res[i].min_ms, emu_mhz(&res[i]), ns_per_tick(&res[i]),
+            frames_per_sec(&res[i]), realtime(&res[i]),
+            __VERSION__, EMU_BENCH_CFLAGS, emu.cpu, emu.num_instances);
+    }
+    fclose(fp);
+}
+
+/* split a CSV line in place, returns the number of fields */
+static int split_csv(char* line, char** fields, int max_fields) {
+    int n = 0;
+    line[strcspn(line, "\r\n")] = 0;
+    fields[n++] = line;
+    for (char* p = line; *p && (n < max_fields); p++) {
+        if (*p == ',') {
+            *p = 0;
+            fields[n++] = p + 1;
+        }
+    }
+    return n;
+}
+
+/* compare ns/tick against the baseline, returns true if any system regressed */
+static bool compare_baseline(const emu_system_t** sel, const emu_result_t* res, int num) {
+    FILE* fp = fopen(emu.baseline_path, "r");
+    if (!fp) {
+        fatal("failed to open baseline file");
+    }
+    bool regressed = false;
+    char line[1024];
+    char* f[16];
+    printf("\nbaseline comparison (%s, threshold %.1f%%):\n", emu.baseline_path, emu.threshold);
+    while (fgets(line, sizeof(line), fp)) {
+        const int num_fields = split_csv(line, f, 16);
+        if ((num_fields < 13) || (0 == strcmp(f[0], "system"))) {
+            continue;
+        }
+        /* baselines from before the instances column ran one instance */
+        const int instances = (num_fields > 13) ? atoi(f[13]) : 1;
+        for (int i = 0; i < num; i++) {
+            if (strcmp(f[0], sel[i]->name)) {
+                continue;
+            }
+            if (strcmp(f[10], __VERSION__) || strcmp(f[11], EMU_BENCH_CFLAGS) || strcmp(f[12], emu.cpu) || (instances != emu.num_instances)) {
+                printf("  %-8s skipped (baseline was recorded with a different compiler, flags, CPU or instance count)\n", f[0]);
+                continue;
+            }
+            const double base = atof(f[7]);
+            const double cur = ns_per_tick(&res[i]);
+            const double pct = 100.0 * (cur - base) / base;
+            const bool bad = pct > emu.threshold;
+            printf("  %-8s %8.3f -> %8.3f ns/tick (%+.1f%%)%s\n", f[0], base, cur, pct, bad ? "  REGRESSED" : "");
+            regressed |= bad;
+        }
+    }
+    fclose(fp);
+    return regressed;
+}
+
+int main(int argc, char* argv[]) {
+    int opt;
+    while ((opt = getopt(argc, argv, "s:n:w:c:b:t:i:q")) != -1) {
+        switch (opt) {
+            case 's': emu.seconds = atoi(optarg); break;
+            case 'n': emu.num_runs = atoi(optarg); break;
+            case 'w': emu.warmup_seconds = atoi(optarg); break;
+            case 'c': emu.csv_path = optarg; break;
+            case 'b': emu.baseline_path = optarg; break;
+            case 't': emu.threshold = atof(optarg); break;
+            case 'i': emu.num_instances = atoi(optarg); break;
+            case 'q': emu.quiet = true; break;
+            default: usage();
+        }
+    }
+    if ((emu.seconds < 1) || (emu.num_runs < 1) || (emu.num_runs > EMU_MAX_RUNS) || (emu.warmup_seconds < 0) ||
+        (emu.num_instances < 1) || (emu.num_instances > EMU_MAX_INSTANCES)) {
+        usage();
+    }
+
+    const emu_system_t* sel[EMU_NUM_SYSTEMS];
+    int num = 0;
+    if (optind == argc) {
+        for (int i = 0; i < EMU_NUM_SYSTEMS; i++) {
+            sel[num++] = &systems[i];
+        }
+    }
+    for (int a = optind; a < argc; a++) {
+        int i;
+        for (i = 0; i < EMU_NUM_SYSTEMS; i++) {
+            if (0 == strcmp(argv[a], systems[i].name)) {
+                break;
+            }
+        }
+        if ((i == EMU_NUM_SYSTEMS) || (num == EMU_NUM_SYSTEMS)) {
+            fprintf(stderr, "emu-bench: unknown system '%s'\n", argv[a]);
+            usage();
+        }
+        sel[num++] = &systems[i];
+    }
+    read_cpu_model();
+
+    static emu_result_t res[EMU_NUM_SYSTEMS];
+    for (int i = 0; i < num; i++) {
+        bench_system(sel[i], &res[i]);
+    }
+
+    if (!emu.quiet) {
+        printf("compiler:  %s\ncflags:    %s\ncpu:       %s\ninstances: %d\n\n", __VERSION__, EMU_BENCH_CFLAGS, emu.cpu, emu.num_instances);
+        printf("%-8s %9s %10s %10s %10s %10s %9s\n", "system", "MHz", "median ms", "emu MHz", "ns/tick", "frames/s", "realtime");
+        for (int i = 0; i < num; i++) {
+            printf("%-8s %9.3f %10.1f %10.2f %10.3f %10.1f %8.1fx\n",
+                sel[i]->name, sel[i]->clk(0)->freq_hz / 1000000.0, res[i].median_ms,
+                emu_mhz(&res[i]), ns_per_tick(&res[i]), frames_per_sec(&res[i]), realtime(&res[i]));
+        }
+    }
+    if (emu.csv_path) {
+        write_csv(sel, res, num);
+    }
+    if (emu.baseline_path && compare_baseline(sel, res, num)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,34 @@
+# headless emulator throughput benchmark
+#
+# Builds emu-bench.c (all seven systems from impl/, running synthetic
+# ROMs) with CC and CFLAGS, runs it, and writes the results to
+# emu-bench.csv. If emu-baseline.csv exists, the ns per emulated tick of
+# each system is compared against it (only for baseline lines recorded
+# with the same compiler, flags and CPU), and the script exits with
+# status 1 if a system got more than THRESHOLD percent slower. UPDATE=1
+# stores the new results as baseline instead. Extra arguments are passed
+# to emu-bench (e.g. system names).
+#
+# Environment:
+#   CC=cc           compiler
+#   CFLAGS=-O2      compile flags
+#   SECS=10         emulated seconds per timed run
+#   RUNS=5          timed runs per system
+#   THRESHOLD=5     regression threshold in percent
+#   INSTANCES=1     emulator instances per system, run interleaved on one core
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:--O2}
+SECS=${SECS:-10}
+RUNS=${RUNS:-5}
+THRESHOLD=${THRESHOLD:-5}
+INSTANCES=${INSTANCES:-1}
+BASELINE=emu-baseline.csv
+
+$CC $CFLAGS -DEMU_BENCH_CFLAGS="\"$CFLAGS\"" -o emu-bench emu-bench.c -lm || exit 1
+if [ -n "$UPDATE" ]; then
+    ./emu-bench -s $SECS -n $RUNS -i $INSTANCES -c emu-bench.csv "$@" && cp emu-bench.csv $BASELINE
+elif [ -f $BASELINE ]; then
+    ./emu-bench -s $SECS -n $RUNS -i $INSTANCES -c emu-bench.csv -b $BASELINE -t $THRESHOLD "$@"
+else
+    ./emu-bench -s $SECS -n $RUNS -i $INSTANCES -c emu-bench.csv "$@"
+fi
@@ -0,0 +1,58 @@
+# before/after emulator throughput comparison
+#
+# Builds emu-bench.c twice, with BASE_CFLAGS and with NEW_CFLAGS (by
+# default without and with CHIPS_INLINE_TICK), runs the two builds
+# alternately for ROUNDS rounds so that host noise hits both the same
+# way, and prints the median ns per emulated tick of each system for both
+# builds and the speedup of the new build. All rounds go to
+# emu-compare.csv (the emu-bench.csv columns with a variant column in
+# front). Extra arguments are passed to emu-bench (e.g. system names).
+#
+# Environment:
+#   CC=cc                                   compiler
+#   BASE_CFLAGS=-O2                         compile flags of the 'before' build
+#   NEW_CFLAGS="-O2 -DCHIPS_INLINE_TICK"    compile flags of the 'after' build
+#   SECS=5                                  emulated seconds per run
+#   ROUNDS=5                                alternating rounds
+CC=${CC:-cc}
+BASE_CFLAGS=${BASE_CFLAGS:--O2}
+NEW_CFLAGS=${NEW_CFLAGS:-"-O2 -DCHIPS_INLINE_TICK"}
+SECS=${SECS:-5}
+ROUNDS=${ROUNDS:-5}
+OUT=_emu-compare
+
+rm -rf $OUT && mkdir -p $OUT
+$CC $BASE_CFLAGS -DEMU_BENCH_CFLAGS="\"$BASE_CFLAGS\"" -o $OUT/base emu-bench.c -lm || exit 1
+$CC $NEW_CFLAGS -DEMU_BENCH_CFLAGS="\"$NEW_CFLAGS\"" -o $OUT/new emu-bench.c -lm || exit 1
+
+echo "variant,system,runs,emu_seconds,freq_mhz,median_ms,min_ms,emu_mhz,ns_per_tick,frames_per_sec,realtime,compiler,cflags,cpu,instances" > emu-compare.csv
+for ((i = 0; i < ROUNDS; i++)); do
+    for v in base new; do
+        $OUT/$v -q -n 1 -w 1 -s $SECS -c $OUT/$v.csv "$@" || exit 1
+        tail -n +2 $OUT/$v.csv | sed "s/^/$v,/" >> emu-compare.csv
+    done
+done
+
+awk -F, -v base_cflags="$BASE_CFLAGS" -v new_cflags="$NEW_CFLAGS" '
+    function median(list,    n, a, i, j, t) {
+        n = split(list, a, " ")
+        for (i = 2; i <= n; i++) {
+            t = a[i]
+            for (j = i - 1; (j > 0) && (a[j] > t); j--) a[j + 1] = a[j]
+            a[j + 1] = t
+        }
+        return (n % 2) ? a[(n + 1) / 2] : (a[n / 2] + a[n / 2 + 1]) / 2
+    }
+    NR > 1 {
+        if (!($2 in seen)) { seen[$2] = 1; order[++num] = $2 }
+        ns[$1, $2] = ns[$1, $2] " " $9
+    }
+    END {
+        printf "base: %s\nnew:  %s\n\n", base_cflags, new_cflags
+        printf "%-8s %12s %12s %9s\n", "system", "base ns/tick", "new ns/tick", "speedup"
+        for (i = 1; i <= num; i++) {
+            s = order[i]
+            b = median(ns["base", s]); n = median(ns["new", s])
+            printf "%-8s %12.3f %12.3f %8.2fx\n", s, b, n, b / n
+        }
+    }' emu-compare.csv
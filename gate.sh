@@ -0,0 +1,15 @@
+# compile-time regression gate
+#
+# Re-runs all run_all.sh variants and compares them against baseline.json,
+# normalized against empty.c/empty.cc on this machine. Exits with status
+# 1 if any variant is more than THRESHOLD percent slower with statistical
+# significance. UPDATE=1 stores the new results as baseline instead.
+#
+#   THRESHOLD=5     regression threshold in percent
+#   RUNS=100        timed runs per variant
+THRESHOLD=${THRESHOLD:-5}
+if [ -n "$UPDATE" ]; then
+    ./run_all.sh && cp results.json baseline.json
+else
+    ./run_all.sh -b baseline.json -t $THRESHOLD
+fi
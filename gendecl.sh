@@ -0,0 +1,103 @@
+# regenerate the decl/ and decl-nocomments/ headers from orig/
+#
+#   decl/X.h            orig/X.h without the CHIPS_IMPL/SOKOL_IMPL block
+#   decl-nocomments/X.h decl/X.h without comments
+#
+# After generating, the script checks that every generated header
+# compiles (with the chip headers it depends on), and that all structs
+# have identical sizeof and offsetof in orig/, decl/ and decl-nocomments/.
+# The struct layouts are taken from the DWARF debug info of a TU which
+# includes all headers (needs readelf from binutils).
+#
+# Run with CHECK_ONLY=1 to only run the checks on the existing headers.
+CC=${CC:-cc}
+OUT=_gendecl
+
+. ./common.sh
+
+# remove the implementation block (and the banner comment before it)
+strip_impl() {
+    awk '
+        skip == 0 && /^#ifdef (CHIPS|SOKOL)_IMPL/ { skip = 1; depth = 1; next }
+        skip {
+            if ($0 ~ /^[ \t]*#[ \t]*if/) depth++
+            else if ($0 ~ /^[ \t]*#[ \t]*endif/ && --depth == 0) skip = 0
+            next
+        }
+        /^\/\*-+ IMPLEMENTATION -+\*\/$/ { next }
+        { lines[++n] = $0 }
+        END {
+            while (n > 0 && lines[n] ~ /^[ \t]*$/) n--
+            for (i = 1; i <= n; i++) print lines[i]
+        }' "$1"
+}
+
+# remove comments, let the compiler do it to get string literals right
+strip_comments() {
+    echo "#pragma once"
+    $CC -fpreprocessed -dD -E -P "$1" 2>/dev/null | grep -v '^[ \t]*$\|^#pragma once'
+}
+
+if [ -z "$CHECK_ONLY" ]; then
+    for h in $HEADERS; do
+        strip_impl orig/$h.h > decl/$h.h
+        strip_comments decl/$h.h > decl-nocomments/$h.h
+        echo "$h.h: $(wc -l < orig/$h.h) => $(wc -l < decl/$h.h) => $(wc -l < decl-nocomments/$h.h) lines"
+    done
+fi
+
+rm -rf $OUT && mkdir -p $OUT
+FAILED=0
+
+# check that each generated header compiles as C and C++
+for dir in decl decl-nocomments; do
+    for h in $HEADERS; do
+        DIR=$dir includes $(deps $h) $h > $OUT/compile.c
+        for lang in c c++; do
+            if ! $CC -x $lang -I. -fsyntax-only $OUT/compile.c; then
+                echo "FAILED: $dir/$h.h does not compile as $lang"
+                FAILED=1
+            fi
+        done
+    done
+done
+
+# dump name, sizeof and member offsetof of every struct and union
+layout() {
+    DIR=$1 includes $HEADERS > $OUT/layout_$1.c
+    $CC -I. -g -fno-eliminate-unused-debug-types -c $OUT/layout_$1.c -o $OUT/layout_$1.o || return 1
+    readelf --debug-dump=info $OUT/layout_$1.o | awk '
+        /^ *<[0-9]+><[0-9a-f]+>: Abbrev Number/ {
+            if (tag != "") emit()
+            tag = $NF; gsub(/[()]/, "", tag); name = ""; size = ""; offset = ""
+            depth = $1; sub(/^</, "", depth); sub(/>.*/, "", depth)
+            next
+        }
+        /DW_AT_name/ { name = $NF }
+        /DW_AT_byte_size/ { size = $NF }
+        /DW_AT_data_member_location/ { offset = $NF }
+        /DW_AT_data_bit_offset/ { offset = "bit:" $NF }
+        function emit() {
+            if (tag == "DW_TAG_structure_type" || tag == "DW_TAG_union_type") {
+                print depth, tag, (name == "" ? "<anon>" : name), "sizeof=" size
+            }
+            else if (tag == "DW_TAG_member") {
+                print depth, "  ", (name == "" ? "<anon>" : name), "offsetof=" offset
+            }
+            else if (tag == "DW_TAG_typedef") {
+                print depth, "typedef", name
+            }
+        }
+        END { if (tag != "") emit() }' > $OUT/layout_$1.txt
+}
+layout orig && layout decl && layout decl-nocomments || FAILED=1
+for dir in decl decl-nocomments; do
+    if ! diff -q $OUT/layout_orig.txt $OUT/layout_$dir.txt > /dev/null; then
+        echo "FAILED: struct layouts in $dir/ differ from orig/ (see $OUT/layout_*.txt)"
+        FAILED=1
+    fi
+done
+if [ $FAILED -eq 0 ]; then
+    echo "OK: all headers compile, $(grep -c 'DW_TAG_structure_type\|DW_TAG_union_type' $OUT/layout_orig.txt) struct/union layouts match"
+fi
+exit $FAILED
@@ -0,0 +1,112 @@
+# per-header compile-cost attribution
+#
+# Measures the cost of each header from decl-orig.c in two ways:
+#
+#   marginal: cost of adding the header to all headers before it
+#             (in decl-orig.c include order)
+#   isolated: cost of the header on its own (system headers like zx.h
+#             together with their chip headers, minus the chip headers)
+#
+# Each number is split into the preprocess (-E), parse (-fsyntax-only)
+# and codegen (-c) phase. The result is a table ranked by marginal cost,
+# also written to headers.csv.
+#
+# Environment:
+#   CC=cc       compiler
+#   DIR=orig    header directory (orig, decl or decl-nocomments)
+#   RUNS=20     timed runs per TU and phase
+#   TUS=400     number of TUs for the 'per-build' estimate column
+CC=${CC:-cc}
+DIR=${DIR:-orig}
+RUNS=${RUNS:-20}
+TUS=${TUS:-400}
+OUT=_headers
+
+. ./common.sh
+
+cc -O2 -o bench bench.c -lm || exit 1
+rm -rf $OUT && mkdir -p $OUT
+
+# generate the translation units
+echo "int i;" > $OUT/empty.c
+VARIANTS="empty"
+INCLUDED=""
+for h in $HEADERS; do
+    INCLUDED="$INCLUDED $h"
+    includes $INCLUDED > $OUT/cum_$h.c
+    includes $(deps $h) $h > $OUT/iso_$h.c
+    VARIANTS="$VARIANTS cum_$h iso_$h"
+    if [ -n "$(deps $h)" ]; then
+        includes $(deps $h) > $OUT/dep_$h.c
+        VARIANTS="$VARIANTS dep_$h"
+    fi
+done
+
+# time each TU in each phase
+phase_cmd() {
+    case $1 in
+        E)            echo "$CC -I. -E $OUT/$2.c -o /dev/null" ;;
+        fsyntax-only) echo "$CC -I. -fsyntax-only $OUT/$2.c" ;;
+        c)            echo "$CC -I. -c $OUT/$2.c -o $OUT/$2.o" ;;
+    esac
+}
+for phase in E fsyntax-only c; do
+    echo "=== phase -$phase ($RUNS runs per TU)"
+    set --
+    for v in $VARIANTS; do
+        set -- "$@" "$v" "$(phase_cmd $phase $v)"
+    done
+    ./bench -q -w 2 -n $RUNS -c $OUT/phase_$phase.csv "$@" || exit 1
+done
+
+# combine the per-phase medians into the ranked table
+awk -F, -v headers="$HEADERS" -v dir="$DIR" -v tus="$TUS" -v out=headers.csv '
+    FNR == 1 { phase++; next }
+    { t[phase, $1] = $4 }
+    function split3(v, base, r) {
+        r["pre"] = t[1, v] - t[1, base]
+        r["parse"] = (t[2, v] - t[1, v]) - (t[2, base] - t[1, base])
+        r["codegen"] = (t[3, v] - t[2, v]) - (t[3, base] - t[2, base])
+    }
+    END {
+        n = split(headers, hdr, /[ \n]+/)
+        prev = "empty"
+        k = 0
+        for (i = 1; i <= n; i++) {
+            h = hdr[i]
+            if (h == "") continue
+            k++
+            name[k] = h
+            split3("cum_" h, prev, m)
+            iso_base = ((1, "dep_" h) in t) ? "dep_" h : "empty"
+            split3("iso_" h, iso_base, s)
+            m_pre[k] = m["pre"]; m_parse[k] = m["parse"]; m_cg[k] = m["codegen"]
+            m_tot[k] = m["pre"] + m["parse"] + m["codegen"]
+            i_pre[k] = s["pre"]; i_parse[k] = s["parse"]; i_cg[k] = s["codegen"]
+            i_tot[k] = s["pre"] + s["parse"] + s["codegen"]
+            cmd = "wc -l < " dir "/" h ".h"
+            cmd | getline lines[k]
+            close(cmd)
+            prev = "cum_" h
+        }
+        full = t[3, prev] - t[3, "empty"]
+        # rank by marginal total (simple selection sort, n is small)
+        for (i = 1; i <= k; i++) order[i] = i
+        for (i = 1; i <= k; i++) {
+            for (j = i + 1; j <= k; j++) {
+                if (m_tot[order[j]] > m_tot[order[i]]) { tmp = order[i]; order[i] = order[j]; order[j] = tmp }
+            }
+        }
+        printf "%-12s %6s | %7s %7s %7s %7s %6s | %7s %7s %7s %7s | %9s\n",
+            "header", "lines", "pre", "parse", "codegen", "marg", "share", "pre", "parse", "codegen", "iso", "x" tus " s"
+        print "header,lines,marginal_pre_ms,marginal_parse_ms,marginal_codegen_ms,marginal_ms,isolated_pre_ms,isolated_parse_ms,isolated_codegen_ms,isolated_ms" > out
+        for (r = 1; r <= k; r++) {
+            i = order[r]
+            printf "%-12s %6d | %7.2f %7.2f %7.2f %7.2f %5.1f%% | %7.2f %7.2f %7.2f %7.2f | %9.2f\n",
+                name[i], lines[i], m_pre[i], m_parse[i], m_cg[i], m_tot[i], (full > 0) ? 100 * m_tot[i] / full : 0,
+                i_pre[i], i_parse[i], i_cg[i], i_tot[i], m_tot[i] * tus / 1000
+            printf "%s,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+                name[i], lines[i], m_pre[i], m_parse[i], m_cg[i], m_tot[i], i_pre[i], i_parse[i], i_cg[i], i_tot[i] > out
+        }
+        printf "all headers: %.2f ms per TU over empty TU, %.2f s for %d TUs\n", full, full * tus / 1000, tus
+    }' $OUT/phase_E.csv $OUT/phase_fsyntax-only.csv $OUT/phase_c.csv
@@ -0,0 +1,29 @@
+/* include the impl/ chips headers and compile the implementation */
+#define CHIPS_IMPL
+#include "impl/beeper.h"
+#include "impl/clk.h"
+#include "impl/crt.h"
+#include "impl/mem.h"
+#include "impl/kbd.h"
+#include "impl/resampler.h"
+
+#include "impl/ay38910.h"
+#include "impl/i8255.h"
+#include "impl/m6502.h"
+#include "impl/m6522.h"
+#include "impl/m6526.h"
+#include "impl/m6569.h"
+#include "impl/m6581.h"
+#include "impl/mc6845.h"
+#include "impl/mc6847.h"
+#include "impl/z80.h"
+#include "impl/z80ctc.h"
+#include "impl/z80pio.h"
+
+#include "impl/atom.h"
+#include "impl/c64.h"
+#include "impl/cpc.h"
+#include "impl/kc85.h"
+#include "impl/z1013.h"
+#include "impl/z9001.h"
+#include "impl/zx.h"
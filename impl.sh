@@ -0,0 +1,111 @@
+# implementation-side compile benchmark (CHIPS_IMPL / SOKOL_IMPL defined)
+#
+# Compiles the impl/ headers in three layouts:
+#
+#   unity:  a single TU with all implementations
+#   header: one TU per header (each with the headers it depends on)
+#   system: one TU per emulated system with all implementations that
+#           system needs, plus one TU for the sokol headers
+#
+# Each layout gets a generated Makefile and is built with 'make -B -jN'
+# at each optimization level and job count. The sokol headers which don't
+# compile on this host (missing platform headers like X11 or ALSA) are
+# skipped with a message. Results go to impl.csv.
+#
+# Environment:
+#   CC=cc                   compiler
+#   RUNS=5                  timed builds per variant
+#   OPTS="-O0 -O2 -O3"      optimization levels
+#   JOBS="1 2 4 <nproc>"    make -j levels
+#   SOKOL_BACKEND=SOKOL_GLCORE33
+CC=${CC:-cc}
+RUNS=${RUNS:-5}
+OPTS=${OPTS:-"-O0 -O2 -O3"}
+JOBS=${JOBS:-$(echo 1 2 4 $(nproc) | tr ' ' '\n' | sort -nu | tr '\n' ' ')}
+SOKOL_BACKEND=${SOKOL_BACKEND:-SOKOL_GLCORE33}
+DIR=impl
+OUT=_impl
+
+. ./common.sh
+
+cc -O2 -o bench bench.c -lm || exit 1
+rm -rf $OUT && mkdir -p $OUT/unity $OUT/header $OUT/system
+
+CHIPS=""
+SOKOL=""
+for h in $HEADERS; do
+    case $h in
+        sokol_*)
+            # only keep sokol headers which compile on this host
+            printf '#define SOKOL_IMPL\n#define %s\n%s\n' $SOKOL_BACKEND "$(includes $h)" > $OUT/probe.c
+            if $CC -I. -fsyntax-only $OUT/probe.c 2> /dev/null; then
+                SOKOL="$SOKOL $h"
+            else
+                echo "skipping $h.h (doesn't compile on this host)"
+            fi
+            ;;
+        *) CHIPS="$CHIPS $h" ;;
+    esac
+done
+rm -f $OUT/probe.c
+
+chips_tu() {
+    includes $(deps $1)
+    echo "#define CHIPS_IMPL"
+    includes $1
+}
+sokol_tu() {
+    printf '#define SOKOL_IMPL\n#define %s\n' $SOKOL_BACKEND
+    includes "$@"
+}
+
+# unity: everything in one TU
+{ echo "#define CHIPS_IMPL"; includes $CHIPS; [ -n "$SOKOL" ] && sokol_tu $SOKOL; } > $OUT/unity/unity.c
+
+# header: one TU per header
+for h in $CHIPS; do
+    chips_tu $h > $OUT/header/$h.c
+done
+for h in $SOKOL; do
+    sokol_tu $h > $OUT/header/$h.c
+done
+
+# system: one TU per system, and one for sokol
+for s in $SYSTEMS; do
+    { echo "#define CHIPS_IMPL"; includes $(deps $s) $s; } > $OUT/system/$s.c
+done
+[ -n "$SOKOL" ] && sokol_tu $SOKOL > $OUT/system/sokol.c
+
+for layout in unity header system; do
+    cat > $OUT/$layout/Makefile <<'MAKEFILE'
+OPT ?= -O2
+OBJS := $(patsubst %.c,%.o,$(wildcard *.c))
+all: $(OBJS)
+%.o: %.c
+	$(CC) $(OPT) -I../.. -c $< -o $@
+MAKEFILE
+done
+
+set --
+for layout in unity header system; do
+    for opt in $OPTS; do
+        for j in $JOBS; do
+            set -- "$@" "$layout$opt-j$j" "make -s -B -j$j -C $OUT/$layout CC=$CC OPT=$opt"
+        done
+    done
+done
+./bench -w 1 -n $RUNS -c impl.csv "$@" || exit 1
+
+# parallel scaling relative to -j1 of the same layout and optimization level
+awk -F, 'NR > 1 {
+        name[NR] = $1; t[$1] = $4; cpu[$1] = $9
+        base = $1; sub(/-j[0-9]+$/, "-j1", base); basename[NR] = base
+        j = $1; sub(/.*-j/, "", j); jobs[NR] = j
+    }
+    END {
+        printf "\n%-20s %10s %10s %8s %10s\n", "variant", "median ms", "cpu ms", "speedup", "efficiency"
+        for (i = 2; i <= NR; i++) {
+            s = t[basename[i]] / t[name[i]]
+            printf "%-20s %10.1f %10.1f %8.2f %9.0f%%\n", name[i], t[name[i]], cpu[name[i]], s, 100 * s / jobs[i]
+        }
+    }' impl.csv
@@ -46,14 +46,22 @@
 /* set N and Z flags depending on value */
 #define _NZ(v) c.P=((c.P&~(M6502_NF|M6502_ZF))|((v&0xFF)?(v&M6502_NF):M6502_ZF))
 
+#if defined(M6502_EXEC_FUNC)
+static uint32_t M6502_EXEC_FUNC(m6502_t* cpu, uint32_t num_ticks) {
+#else
 uint32_t m6502_exec(m6502_t* cpu, uint32_t num_ticks) {
+#endif
   m6502_state_t c = cpu->state;
   int trap_id = -1;
   uint8_t l, h;
   uint16_t a, t;
   uint32_t ticks = 0;
   uint64_t pins = c.PINS;
+#if defined(M6502_EXEC_TICK)
+  #define tick M6502_EXEC_TICK
+#else
   const m6502_tick_t tick = cpu->tick;
+#endif
   void* ud = cpu->user_data;
   do {
     uint64_t pre_pins = pins;
@@ -354,6 +362,9 @@ uint32_t m6502_exec(m6502_t* cpu, uint32_t num_ticks) {
   cpu->trap_id = trap_id;
   return ticks;
 }
+#if defined(M6502_EXEC_TICK)
+  #undef tick
+#endif
 #undef _SA
 #undef _SAD
 #undef _GD
@@ -0,0 +1,26 @@
+/*
+    Stamps out a static m6502_exec() variant which calls a tick function
+    known at compile time instead of the m6502_t tick callback pointer,
+    so that the compiler can inline the tick function into the decoder.
+
+    Include this after m6502.h (with CHIPS_IMPL), with M6502_EXEC_FUNC
+    defined as the name of the new function and M6502_EXEC_TICK as the
+    name of the tick function (which must be declared before), for
+    instance:
+
+    ~~~C
+    #define M6502_EXEC_FUNC _c64_m6502_exec
+    #define M6502_EXEC_TICK _c64_tick
+    #include "_m6502_exec.h"
+    ~~~
+
+    The generated function has the same signature and behaviour as
+    m6502_exec(), the user_data pointer from m6502_desc_t is still passed
+    to the tick function. Both macros are undefined at the end.
+*/
+#if !defined(M6502_EXEC_FUNC) || !defined(M6502_EXEC_TICK)
+#error "please define M6502_EXEC_FUNC and M6502_EXEC_TICK before including _m6502_exec.h"
+#endif
+#include "_m6502_decoder.h"
+#undef M6502_EXEC_FUNC
+#undef M6502_EXEC_TICK
@@ -1,4 +1,8 @@
+#if defined(Z80_EXEC_FUNC)
+static uint32_t Z80_EXEC_FUNC(z80_t* cpu, uint32_t num_ticks) {
+#else
 uint32_t z80_exec(z80_t* cpu, uint32_t num_ticks) {
+#endif
   uint64_t r0 = cpu->bc_de_hl_fa;
   uint64_t r1 = cpu->wz_ix_iy_sp;
   uint64_t r2 = cpu->im_ir_pc_bits;
@@ -7,7 +11,11 @@ uint32_t z80_exec(z80_t* cpu, uint32_t num_ticks) {
   uint64_t map_bits = r2 & _BITS_MAP_REGS;
   uint64_t pins = cpu->pins;
   const uint64_t trap_addr = cpu->trap_addr;
+#if defined(Z80_EXEC_TICK)
+  #define tick Z80_EXEC_TICK
+#else
   const z80_tick_t tick = cpu->tick;
+#endif
   void* ud = cpu->user_data;
   int trap_id = -1;
   uint32_t ticks = 0;
@@ -545,3 +553,6 @@ uint32_t z80_exec(z80_t* cpu, uint32_t num_ticks) {
   cpu->trap_id = trap_id;
   return ticks;
 }
+#if defined(Z80_EXEC_TICK)
+  #undef tick
+#endif
@@ -0,0 +1,34 @@
+/*
+    Stamps out a static z80_exec() variant which calls a tick function
+    known at compile time instead of the z80_t tick callback pointer, so
+    that the compiler can inline the tick function into the decoder.
+
+    Include this after z80.h (with CHIPS_IMPL), with Z80_EXEC_FUNC defined
+    as the name of the new function and Z80_EXEC_TICK as the name of the
+    tick function (which must be declared before), for instance:
+
+    ~~~C
+    #define Z80_EXEC_FUNC _zx_z80_exec
+    #define Z80_EXEC_TICK _zx_tick
+    #include "_z80_exec.h"
+    ~~~
+
+    The generated function has the same signature and behaviour as
+    z80_exec(), the user_data pointer from z80_desc_t is still passed
+    to the tick function. Both macros are undefined at the end.
+*/
+#if !defined(Z80_EXEC_FUNC) || !defined(Z80_EXEC_TICK)
+#error "please define Z80_EXEC_FUNC and Z80_EXEC_TICK before including _z80_exec.h"
+#endif
+#include "_z80_macros.h"
+#ifdef _MSC_VER
+#pragma warning (push)
+#pragma warning (disable: 4065) // switch statement contains 'default' but no 'case' labels
+#endif
+#include "_z80_decoder.h"
+#ifdef _MSC_VER
+#pragma warning (pop)
+#endif
+#include "_z80_undef.h"
+#undef Z80_EXEC_FUNC
+#undef Z80_EXEC_TICK
@@ -0,0 +1,135 @@
+/* private macros of the z80.h implementation, also used by _z80_exec.h */
+/* register locations in register banks */
+#define _A (0)
+#define _F (8)
+#define _L (16)
+#define _H (24)
+#define _E (32)
+#define _D (40)
+#define _C (48)
+#define _B (56)
+#define _FA (0)
+#define _HL (16)
+#define _DE (32)
+#define _BC (48)
+#define _SP (0)
+#define _IY (16)
+#define _IX (32)
+#define _WZ (48)
+#define _PC (16)
+#define _IR (32)
+#define _R  (32)
+#define _I  (40)
+#define _IM (48)
+#define _USE_IX (0)
+#define _USE_IY (1)
+#define _IFF1 (2)
+#define _IFF2 (3)
+#define _EI   (4)
+#define _BIT_USE_IX (1ULL<<_USE_IX)
+#define _BIT_USE_IY (1ULL<<_USE_IY)
+#define _BIT_IFF1   (1ULL<<_IFF1)
+#define _BIT_IFF2   (1ULL<<_IFF2)
+#define _BIT_EI     (1ULL<<_EI)
+#define _BITS_MAP_REGS (_BIT_USE_IX|_BIT_USE_IY)
+
+/* set 8-bit immediate value in 64-bit register bank */
+#define _S8(bank,shift,val) bank=(((bank)&~(0xFFULL<<(shift)))|(((val)&0xFFULL)<<(shift)))
+/* extract 8-bit value from 64-bit register bank */
+#define _G8(bank,shift) (((bank)>>(shift))&0xFFULL)
+/* set 16-bit immediate value in 64-bit register bank */
+#define _S16(bank,shift,val) bank=((bank&~(0xFFFFULL<<(shift)))|(((val)&0xFFFFULL)<<(shift)))
+/* extract 16-bit value from 64-bit register bank */
+#define _G16(bank,shift) (((bank)>>(shift))&0xFFFFULL)
+/* set a single bit value in 64-bit register mask */
+#define _S1(bank,shift,val) bank=(((bank)&~(1ULL<<(shift)))|(((val)&1ULL)<<(shift)))
+/* set 16-bit address bus pins */
+#define _SA(addr) pins=(pins&~0xFFFFULL)|((addr)&0xFFFFULL)
+/* set 16-bit address bus and 8-bit data bus pins */
+#define _SAD(addr,data) pins=(pins&~0xFFFFFFULL)|((((data)&0xFFULL)<<16)&0xFF0000ULL)|((addr)&0xFFFFULL)
+/* get 8-bit data bus value from pins */
+#define _GD() ((uint8_t)((pins&0xFF0000ULL)>>16))
+/* invoke 'filler tick' without control pins set */
+#define _T(num) pins=tick(num,(pins&~Z80_CTRL_MASK),ud);ticks+=num
+/* invoke tick callback with pins mask */
+#define _TM(num,mask) pins=tick(num,(pins&~(Z80_CTRL_MASK))|(mask),ud);ticks+=num
+/* invoke tick callback (with wait state detecion) */
+#define _TWM(num,mask) pins=tick(num,(pins&~(Z80_WAIT_MASK|Z80_CTRL_MASK))|(mask),ud);ticks+=num+Z80_GET_WAIT(pins)
+/* memory read machine cycle */
+#define _MR(addr,data) _SA(addr);_TWM(3,Z80_MREQ|Z80_RD);data=_GD()
+/* memory write machine cycle */
+#define _MW(addr,data) _SAD(addr,data);_TWM(3,Z80_MREQ|Z80_WR)
+/* input machine cycle */
+#define _IN(addr,data) _SA(addr);_TWM(4,Z80_IORQ|Z80_RD);data=_GD()
+/* output machine cycle */
+#define _OUT(addr,data) _SAD(addr,data);_TWM(4,Z80_IORQ|Z80_WR);
+/* read 8-bit immediate value */
+#define _IMM8(data) _MR(pc++,data);
+/* read 16-bit immediate value (also update WZ register) */
+#define _IMM16(data) {uint8_t w,z;_MR(pc++,z);_MR(pc++,w);data=(w<<8)|z;_S_WZ(data);} 
+/* true if current op is an indexed op */
+#define _IDX() (0!=(r2&(_BIT_USE_IX|_BIT_USE_IY)))
+/* generate effective address for (HL), (IX+d), (IY+d) */
+#define _ADDR(addr,ext_ticks) {addr=_G16(ws,_HL);if(_IDX()){int8_t d;_MR(pc++,d);addr+=d;_S_WZ(addr);_T(ext_ticks);}}
+/* helper macro to bump R register */
+#define _BUMPR() d8=_G8(r2,_R);d8=(d8&0x80)|((d8+1)&0x7F);_S8(r2,_R,d8)
+/* a normal opcode fetch, bump R */
+#define _FETCH(op) {_SA(pc++);_TWM(4,Z80_M1|Z80_MREQ|Z80_RD);op=_GD();_BUMPR();}
+/* special opcode fetch for CB prefix, only bump R if not a DD/FD+CB 'double prefix' op */
+#define _FETCH_CB(op) {_SA(pc++);_TWM(4,Z80_M1|Z80_MREQ|Z80_RD);op=_GD();if(!_IDX()){_BUMPR();}}
+/* evaluate S+Z flags */
+#define _SZ(val) ((val&0xFF)?(val&Z80_SF):Z80_ZF)
+/* evaluate SZYXCH flags */
+#define _SZYXCH(acc,val,res) (_SZ(res)|(res&(Z80_YF|Z80_XF))|((res>>8)&Z80_CF)|((acc^val^res)&Z80_HF))
+/* evaluate flags for 8-bit adds */
+#define _ADD_FLAGS(acc,val,res) (_SZYXCH(acc,val,res)|((((val^acc^0x80)&(val^res))>>5)&Z80_VF))
+/* evaluate flags for 8-bit subs */
+#define _SUB_FLAGS(acc,val,res) (Z80_NF|_SZYXCH(acc,val,res)|((((val^acc)&(res^acc))>>5)&Z80_VF))
+/* evaluate flags for 8-bit compare */
+#define _CP_FLAGS(acc,val,res) (Z80_NF|(_SZ(res)|(val&(Z80_YF|Z80_XF))|((res>>8)&Z80_CF)|((acc^val^res)&Z80_HF))|((((val^acc)&(res^acc))>>5)&Z80_VF))
+/* evaluate flags for LD A,I and LD A,R */
+#define _SZIFF2_FLAGS(val) ((_G_F()&Z80_CF)|_SZ(val)|(val&(Z80_YF|Z80_XF))|((r2&_BIT_IFF2)?Z80_PF:0))
+
+#define _S_A(val)  _S8(ws,_A,val)
+#define _S_F(val)  _S8(ws,_F,val)
+#define _S_L(val)  _S8(ws,_L,val)
+#define _S_H(val)  _S8(ws,_H,val)
+#define _S_E(val)  _S8(ws,_E,val)
+#define _S_D(val)  _S8(ws,_D,val)
+#define _S_C(val)  _S8(ws,_C,val)
+#define _S_B(val)  _S8(ws,_B,val)
+#define _S_FA(val) _S16(ws,_FA,val)
+#define _S_HL(val) _S16(ws,_HL,val)
+#define _S_DE(val) _S16(ws,_DE,val)
+#define _S_BC(val) _S16(ws,_BC,val)
+#define _S_WZ(val) _S16(r1,_WZ,val)
+#define _S_IX(val) _S16(r1,_IX,val)
+#define _S_IY(val) _S16(r1,_IY,val)
+#define _S_SP(val) _S16(r1,_SP,val)
+#define _S_IM(val) _S8(r2,_IM,val)
+#define _S_I(val)  _S8(r2,_I,val)
+#define _S_R(val)  _S8(r2,_R,val)
+#define _S_IR(val) _S16(r2,_IR,val)
+#define _S_PC(val) _S16(r2,_PC,val)
+
+#define _G_A()  _G8(ws,_A)
+#define _G_F()  _G8(ws,_F)
+#define _G_L()  _G8(ws,_L)
+#define _G_H()  _G8(ws,_H)
+#define _G_E()  _G8(ws,_E)
+#define _G_D()  _G8(ws,_D)
+#define _G_C()  _G8(ws,_C)
+#define _G_B()  _G8(ws,_B)
+#define _G_FA() _G16(ws,_FA)
+#define _G_HL() _G16(ws,_HL)
+#define _G_DE() _G16(ws,_DE)
+#define _G_BC() _G16(ws,_BC)
+#define _G_WZ() _G16(r1,_WZ)
+#define _G_IX() _G16(r1,_IX)
+#define _G_IY() _G16(r1,_IY)
+#define _G_SP() _G16(r1,_SP)
+#define _G_IM() _G8(r2,_IM)
+#define _G_I()  _G8(r2,_I)
+#define _G_R()  _G8(r2,_R)
+#define _G_IR() _G16(r2,_IR)
+#define _G_PC() _G16(r2,_PC)
@@ -0,0 +1,104 @@
+/* undefine the private macros from _z80_macros.h */
+#undef _A
+#undef _F
+#undef _L
+#undef _H
+#undef _E
+#undef _D
+#undef _C
+#undef _B
+#undef _FA
+#undef _HL
+#undef _DE
+#undef _BC
+#undef _SP
+#undef _WZ
+#undef _PC
+#undef _IR
+#undef _R 
+#undef _I 
+#undef _IX
+#undef _IY
+#undef _IM
+#undef _IFF1
+#undef _IFF2
+#undef _EI  
+#undef _USE_IX
+#undef _USE_IY
+#undef _BIT_IFF1
+#undef _BIT_IFF2
+#undef _BIT_EI  
+#undef _BIT_USE_IX
+#undef _BIT_USE_IY
+#undef _BITS_MAP_REGS
+#undef _S8
+#undef _G8
+#undef _S16
+#undef _G16
+#undef _S1
+#undef _SA
+#undef _SAD
+#undef _GD
+#undef _T
+#undef _TM
+#undef _TWM
+#undef _MR
+#undef _MW
+#undef _IN
+#undef _OUT
+#undef _IMM8
+#undef _IMM16
+#undef _IDX
+#undef _ADDR
+#undef _BUMPR
+#undef _FETCH
+#undef _FETCH_CB
+#undef _SZ
+#undef _SZYXCH
+#undef _ADD_FLAGS
+#undef _SUB_FLAGS
+#undef _CP_FLAGS
+#undef _SZIFF2_FLAGS
+#undef _S_A
+#undef _S_F
+#undef _S_L
+#undef _S_H
+#undef _S_E
+#undef _S_D
+#undef _S_C
+#undef _S_B
+#undef _S_FA
+#undef _S_HL
+#undef _S_DE
+#undef _S_BC
+#undef _S_WZ
+#undef _S_IX
+#undef _S_IY
+#undef _S_SP
+#undef _S_IM
+#undef _S_I
+#undef _S_R
+#undef _S_IR
+#undef _S_PC
+#undef _S_I
+#undef _G_A
+#undef _G_F
+#undef _G_L
+#undef _G_H
+#undef _G_E
+#undef _G_D
+#undef _G_C
+#undef _G_B
+#undef _G_FA 
+#undef _G_HL 
+#undef _G_DE 
+#undef _G_BC 
+#undef _G_WZ 
+#undef _G_IX 
+#undef _G_IY 
+#undef _G_SP 
+#undef _G_IM
+#undef _G_I
+#undef _G_R
+#undef _G_IR 
+#undef _G_PC 
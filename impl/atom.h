@@ -18,6 +18,14 @@
     ~~~
         your own assert macro (default: assert(c))
 
+    Define the following macro to make atom_exec() run a copy of
+    m6502_exec() with the tick function known at compile time (see the
+    'Compile-time tick callback' section in m6502.h):
+
+    ~~~C
+    CHIPS_INLINE_TICK
+    ~~~
+
     You need to include the following headers before including atom.h:
 
     - chips/m6502.h
@@ -202,6 +210,16 @@ static void _atom_init_keymap(atom_t* sys);
 static void _atom_init_memorymap(atom_t* sys);
 static void _atom_osload(atom_t* sys);
 
+#ifdef CHIPS_INLINE_TICK
+/* an m6502_exec() copy which calls _atom_tick() directly, see _m6502_exec.h */
+#define M6502_EXEC_FUNC _atom_m6502_exec
+#define M6502_EXEC_TICK _atom_tick
+#include "_m6502_exec.h"
+#define _ATOM_M6502_EXEC _atom_m6502_exec
+#else
+#define _ATOM_M6502_EXEC m6502_exec
+#endif
+
 #define _ATOM_DEFAULT(val,def) (((val) != 0) ? (val) : (def))
 #define _ATOM_CLEAR(val) memset(&val, 0, sizeof(val))
 
@@ -293,7 +311,7 @@ void atom_exec(atom_t* sys, uint32_t micro_seconds) {
     uint32_t ticks_to_run = clk_ticks_to_run(&sys->clk, micro_seconds);
     uint32_t ticks_executed = 0;
     while (ticks_executed < ticks_to_run) {
-        ticks_executed += m6502_exec(&sys->cpu, ticks_to_run);
+        ticks_executed += _ATOM_M6502_EXEC(&sys->cpu, ticks_to_run);
         /* check if the trapped OSLoad function was hit to implement tape file loading */
         if (1 == sys->cpu.trap_id) {
             _atom_osload(sys);
@@ -33,6 +33,17 @@
       a CP1610 CPU
     - the RESET pin state is ignored, instead call ay38910_reset()
 
+    BLOCK RENDERING:
+
+    Instead of calling ay38910_tick() on every chip clock, an emulator
+    can count the ticks the chip is behind, and only call
+    ay38910_render() with that number of ticks before writing a chip
+    register via ay38910_iorq(), and when it needs a block of audio
+    samples. ay38910_render() only does work when a tone, noise or
+    envelope counter flips or a sample is due, and writes the samples
+    into a buffer. When the buffer is full, the remaining ticks are kept
+    and rendered first by the next call.
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -212,6 +223,7 @@ typedef struct {
     int sample_counter;
     float mag;
     float sample;
+    uint32_t pending_ticks;     /* ticks left over by ay38910_render() when the buffer was full */
 } ay38910_t;
 
 /* extract 8-bit data bus from 64-bit pins */
@@ -227,6 +239,8 @@ extern void ay38910_reset(ay38910_t* ay);
 extern uint64_t ay38910_iorq(ay38910_t* ay, uint64_t pins);
 /* tick the AY-3-8910, return true if a new sample is ready */
 extern bool ay38910_tick(ay38910_t* ay);
+/* advance the AY-3-8910 by num_ticks, write new samples to out, return number of samples written */
+extern int ay38910_render(ay38910_t* ay, uint32_t num_ticks, float* out, int max_samples);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -383,6 +397,7 @@ void ay38910_reset(ay38910_t* ay) {
     CHIPS_ASSERT(ay);
     ay->addr = 0;
     ay->tick = 0;
+    ay->pending_ticks = 0;
     for (int i = 0; i < AY38910_NUM_REGISTERS; i++) {
         ay->reg[i] = 0;
     }
@@ -390,74 +405,145 @@ void ay38910_reset(ay38910_t* ay) {
     _ay38910_restart_env_shape(ay);
 }
 
-bool ay38910_tick(ay38910_t* ay) {
-    ay->tick++;
-    if ((ay->tick & 7) == 0) {
-        /* tick the tone channels */
-        for (int i = 0; i < AY38910_NUM_CHANNELS; i++) {
-            ay38910_tone_t* chn = &ay->tone[i];
-            if (++chn->counter >= chn->period) {
-                chn->counter = 0;
-                chn->bit ^= 1;
-            }
+/* compute the current output sample */
+static float _ay38910_sample(const ay38910_t* ay) {
+    float vol = 0.0f;
+    float sm = 0.0f;
+    for (int i = 0; i < AY38910_NUM_CHANNELS; i++) {
+        const ay38910_tone_t* chn = &ay->tone[i];
+        if (0 == (ay->reg[AY38910_REG_AMP_A+i] & (1<<4))) {
+            /* fixed amplitude */
+            vol = _ay38910_volumes[ay->reg[AY38910_REG_AMP_A+i] & 0x0F];
+        }
+        else {
+            /* envelope control */
+            vol = _ay38910_volumes[ay->env.shape_state];
         }
+        int vol_enable = (chn->bit|chn->tone_disable) & ((ay->noise.rng&1)|(chn->noise_disable));
+        sm += (vol_enable ? vol : -vol);
+    }
+    return sm * ay->mag * 0.33333f;
+}
 
-        /* tick the noise channel */
-        if (++ay->noise.counter >= ay->noise.period) {
-            ay->noise.counter = 0;
-            ay->noise.bit ^= 1;
-            if (ay->noise.bit) {
-                // random number generator from MAME:
-                // https://github.com/mamedev/mame/blob/master/src/devices/sound/ay8910.cpp
-                // The Random Number Generator of the 8910 is a 17-bit shift
-                // register. The input to the shift register is bit0 XOR bit3
-                // (bit0 is the output). This was verified on AY-3-8910 and YM2149 chips.
-                ay->noise.rng ^= (((ay->noise.rng & 1) ^ ((ay->noise.rng >> 3) & 1)) << 17);
-                ay->noise.rng >>= 1;
-            }
+/* advance the tone and noise counters (steps must not go past a flip) */
+static inline void _ay38910_step_tones(ay38910_t* ay, uint32_t steps) {
+    for (int i = 0; i < AY38910_NUM_CHANNELS; i++) {
+        ay38910_tone_t* chn = &ay->tone[i];
+        chn->counter += steps;
+        const uint32_t flip = (chn->counter >= chn->period);
+        chn->counter = flip ? 0 : chn->counter;
+        chn->bit ^= flip;
+    }
+    ay->noise.counter += steps;
+    if (ay->noise.counter >= ay->noise.period) {
+        ay->noise.counter = 0;
+        ay->noise.bit ^= 1;
+        if (ay->noise.bit) {
+            // random number generator from MAME:
+            // https://github.com/mamedev/mame/blob/master/src/devices/sound/ay8910.cpp
+            // The Random Number Generator of the 8910 is a 17-bit shift
+            // register. The input to the shift register is bit0 XOR bit3
+            // (bit0 is the output). This was verified on AY-3-8910 and YM2149 chips.
+            ay->noise.rng ^= (((ay->noise.rng & 1) ^ ((ay->noise.rng >> 3) & 1)) << 17);
+            ay->noise.rng >>= 1;
         }
     }
+}
 
-    /* tick the envelope generator */
-    if ((ay->tick & 15) == 0) {
-        if (++ay->env.counter >= ay->env.period) {
-            ay->env.counter = 0;
-            if (!ay->env.shape_holding) {
-                ay->env.shape_counter = (ay->env.shape_counter + 1) & 0x1F;
-                if (ay->env.shape_hold && (0x1F == ay->env.shape_counter)) {
-                    ay->env.shape_holding = true;
-                }
+/* advance the envelope counter (steps must not go past a flip) */
+static inline void _ay38910_step_env(ay38910_t* ay, uint32_t steps) {
+    ay->env.counter += steps;
+    if (ay->env.counter >= ay->env.period) {
+        ay->env.counter = 0;
+        if (!ay->env.shape_holding) {
+            ay->env.shape_counter = (ay->env.shape_counter + 1) & 0x1F;
+            if (ay->env.shape_hold && (0x1F == ay->env.shape_counter)) {
+                ay->env.shape_holding = true;
             }
-            ay->env.shape_state = _ay38910_shapes[ay->env_shape_cycle][ay->env.shape_counter];
         }
+        ay->env.shape_state = _ay38910_shapes[ay->env_shape_cycle][ay->env.shape_counter];
     }
+}
 
+bool ay38910_tick(ay38910_t* ay) {
+    ay->tick++;
+    /* tick the tone channels and noise generator */
+    if ((ay->tick & 7) == 0) {
+        _ay38910_step_tones(ay, 1);
+    }
+    /* tick the envelope generator */
+    if ((ay->tick & 15) == 0) {
+        _ay38910_step_env(ay, 1);
+    }
     /* generate new sample? */
     ay->sample_counter -= AY38910_FIXEDPOINT_SCALE;
     if (ay->sample_counter <= 0) {
         ay->sample_counter += ay->sample_period;
-        float vol = 0.0f;
-        float sm = 0.0f;
-        for (int i = 0; i < AY38910_NUM_CHANNELS; i++) {
-            const ay38910_tone_t* chn = &ay->tone[i];
-            if (0 == (ay->reg[AY38910_REG_AMP_A+i] & (1<<4))) {
-                /* fixed amplitude */
-                vol = _ay38910_volumes[ay->reg[AY38910_REG_AMP_A+i] & 0x0F];
-            }
-            else {
-                /* envelope control */
-                vol = _ay38910_volumes[ay->env.shape_state];
-            }
-            int vol_enable = (chn->bit|chn->tone_disable) & ((ay->noise.rng&1)|(chn->noise_disable));
-            sm += (vol_enable ? vol : -vol);
-        }
-        ay->sample = sm * ay->mag * 0.33333f;
+        ay->sample = _ay38910_sample(ay);
         return true;    /* new sample is ready */
     }
     /* fallthrough: no new sample ready yet */
     return false;
 }
 
+/* number of counter steps until a counter flips (at least 1) */
+static inline uint32_t _ay38910_steps(uint16_t counter, uint16_t period) {
+    return (counter < period) ? (period - counter) : 1;
+}
+
+/*
+    The tone and noise counters step on every 8th tick, the envelope
+    counter on every 16th tick. Between two counter flips and samples
+    the output doesn't change, so ay38910_render() jumps directly from
+    one such event to the next.
+*/
+int ay38910_render(ay38910_t* ay, uint32_t num_ticks, float* out, int max_samples) {
+    CHIPS_ASSERT(ay && out && (max_samples >= 0));
+    num_ticks += ay->pending_ticks;
+    ay->pending_ticks = 0;
+    int num_samples = 0;
+    while (num_ticks > 0) {
+        /* ticks until the next sample, tone/noise flip and envelope step */
+        const uint32_t to_sample = (ay->sample_counter + AY38910_FIXEDPOINT_SCALE - 1) / AY38910_FIXEDPOINT_SCALE;
+        uint32_t steps = _ay38910_steps(ay->noise.counter, ay->noise.period);
+        for (int i = 0; i < AY38910_NUM_CHANNELS; i++) {
+            const uint32_t s = _ay38910_steps(ay->tone[i].counter, ay->tone[i].period);
+            steps = (s < steps) ? s : steps;
+        }
+        const uint32_t to_tone = (8 - (ay->tick & 7)) + 8 * (steps - 1);
+        const uint32_t to_env = (16 - (ay->tick & 15)) + 16 * (_ay38910_steps(ay->env.counter, ay->env.period) - 1);
+        uint32_t n = to_sample;
+        n = (to_tone < n) ? to_tone : n;
+        n = (to_env < n) ? to_env : n;
+        if ((n == to_sample) && (n <= num_ticks) && (num_samples == max_samples)) {
+            /* out of buffer space, stop right before the sample */
+            n--;
+            ay->pending_ticks = num_ticks - n;
+            num_ticks = n;
+        }
+        n = (num_ticks < n) ? num_ticks : n;
+        num_ticks -= n;
+
+        /* advance the counters, none of them can flip before the last tick */
+        const uint32_t tone_steps = ((ay->tick & 7) + n) >> 3;
+        const uint32_t env_steps = ((ay->tick & 15) + n) >> 4;
+        ay->tick += n;
+        ay->sample_counter -= n * AY38910_FIXEDPOINT_SCALE;
+        if (tone_steps > 0) {
+            _ay38910_step_tones(ay, tone_steps);
+        }
+        if (env_steps > 0) {
+            _ay38910_step_env(ay, env_steps);
+        }
+        if (ay->sample_counter <= 0) {
+            ay->sample_counter += ay->sample_period;
+            ay->sample = _ay38910_sample(ay);
+            out[num_samples++] = ay->sample;
+        }
+    }
+    return num_samples;
+}
+
 uint64_t ay38910_iorq(ay38910_t* ay, uint64_t pins) {
     if (pins & (AY38910_BDIR|AY38910_BC1)) {
         if (pins & AY38910_BDIR) {
@@ -2,7 +2,17 @@
 /*
     beeper.h    -- simple square-wave beeper
 
-    TODO: docs
+    The beeper only does work when its on/off state changes: each edge
+    is placed at its tick offset into the current sample period and
+    rendered as a band-limited step (BLEP), so the output has no aliasing
+    from the point-sampled square wave. The emulator advances the beeper
+    once per CPU tick callback with beeper_ticks() instead of once per
+    clock cycle, and edges which happen inside the ticks of a callback go
+    through beeper_set_at() and beeper_toggle_at() with their tick offset
+    (relative to the start of the ticks passed to the next
+    beeper_ticks()). The number of ticks per beeper_ticks() call must be
+    smaller than the number of ticks per sample. The band-limited steps
+    delay the output by BEEPER_BLEP_TAPS/2 samples.
 
     ## zlib/libpng license
 
@@ -25,12 +35,23 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /* error-accumulation precision boost */
 #define BEEPER_FIXEDPOINT_SCALE (16)
+/* number of sub-sample positions of a band-limited step */
+#define BEEPER_BLEP_PHASES (32)
+/* length of a band-limited step in samples */
+#define BEEPER_BLEP_TAPS (8)
+/* ring buffer size for pending band-limited steps (must be 2^N) */
+#define BEEPER_BLEP_RING (2*BEEPER_BLEP_TAPS)
 
 /* beeper state */
 typedef struct {
@@ -39,31 +60,65 @@ typedef struct {
     int counter;
     float mag;
     float sample;
+    /* output level and pending band-limited step deltas */
+    float level;
+    int pending;
+    int ring_pos;
+    float ring[BEEPER_BLEP_RING];
 } beeper_t;
 
 /* initialize beeper instance */
 extern void beeper_init(beeper_t* beeper, int tick_hz, int sound_hz, float magnitude);
 /* reset the beeper instance */
 extern void beeper_reset(beeper_t* beeper);
+/* add a band-limited step of delta to the output level at a tick offset into the next beeper_ticks() */
+extern void beeper_step_at(beeper_t* beeper, int tick, float delta);
+/* set on/off state at a tick offset into the next beeper_ticks() */
+static inline void beeper_set_at(beeper_t* beeper, int tick, bool state) {
+    const int s = state ? 1 : 0;
+    if (s != beeper->state) {
+        beeper->state = s;
+        beeper_step_at(beeper, tick, s ? beeper->mag : -beeper->mag);
+    }
+}
+/* toggle state at a tick offset into the next beeper_ticks() */
+static inline void beeper_toggle_at(beeper_t* beeper, int tick) {
+    beeper_set_at(beeper, tick, !beeper->state);
+}
 /* set current on/off state */
 static inline void beeper_set(beeper_t* beeper, bool state) {
-    beeper->state = state ? 1 : 0;
+    beeper_set_at(beeper, 0, state);
 }
 /* toggle current state (on->off or off->on) */
 static inline void beeper_toggle(beeper_t* beeper) {
-    beeper->state = !beeper->state;
+    beeper_set_at(beeper, 0, !beeper->state);
 }
-/* tick the beeper, return true if a new sample is ready */
-static inline bool beeper_tick(beeper_t* beeper) {
+/* advance the beeper by num_ticks, return true if a new sample is ready */
+static inline bool beeper_ticks(beeper_t* beeper, int num_ticks) {
+    CHIPS_ASSERT(num_ticks * BEEPER_FIXEDPOINT_SCALE < beeper->period);
     /* generate a new sample? */
-    beeper->counter -= BEEPER_FIXEDPOINT_SCALE;
+    beeper->counter -= num_ticks * BEEPER_FIXEDPOINT_SCALE;
     if (beeper->counter <= 0) {
         beeper->counter += beeper->period;
-        beeper->sample = ((float)beeper->state) * beeper->mag;
+        if (beeper->pending > 0) {
+            float* d = &beeper->ring[beeper->ring_pos];
+            beeper->level += *d;
+            *d = 0.0f;
+            beeper->ring_pos = (beeper->ring_pos + 1) & (BEEPER_BLEP_RING-1);
+            if (--beeper->pending == 0) {
+                /* all steps have settled, drop the accumulated rounding error */
+                beeper->level = ((float)beeper->state) * beeper->mag;
+            }
+        }
+        beeper->sample = beeper->level;
         return true;
     }
     return false;
 }
+/* tick the beeper, return true if a new sample is ready */
+static inline bool beeper_tick(beeper_t* beeper) {
+    return beeper_ticks(beeper, 1);
+}
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -81,6 +136,45 @@ static inline bool beeper_tick(beeper_t* beeper) {
     #define CHIPS_ASSERT(c) assert(c)
 #endif
 
+/* band-limited impulse per sub-sample position (Blackman-windowed sinc
+   with the cutoff at 0.9 times half the sample rate), each row sums to 1
+*/
+static const float _beeper_blep[BEEPER_BLEP_PHASES+1][BEEPER_BLEP_TAPS] = {
+    { 1.127790861e-09f, 5.703893024e-03f, -3.180751204e-02f, 7.609125972e-02f, 9.000247121e-01f, 7.609125972e-02f, -3.180751204e-02f, 5.703893024e-03f },
+    { -4.237627309e-06f, 6.557713263e-03f, -3.742421791e-02f, 1.011791155e-01f, 8.986291885e-01f, 5.258040875e-02f, -2.641132846e-02f, 4.893367179e-03f },
+    { -1.738066931e-05f, 7.446879055e-03f, -4.321738705e-02f, 1.277754307e-01f, 8.944523931e-01f, 3.070103005e-02f, -2.127353102e-02f, 4.132580478e-03f },
+    { -3.978814493e-05f, 8.361843415e-03f, -4.913688824e-02f, 1.557976007e-01f, 8.875229955e-01f, 1.049363241e-02f, -1.642582938e-02f, 3.426486161e-03f },
+    { -7.144641859e-05f, 9.291429073e-03f, -5.512640998e-02f, 1.851494014e-01f, 8.778878450e-01f, -8.015434258e-03f, -1.189395972e-02f, 2.778627910e-03f },
+    { -1.119289882e-04f, 1.022284664e-02f, -6.112366542e-02f, 2.157213390e-01f, 8.656114340e-01f, -2.481346577e-02f, -7.697863504e-03f, 2.191273961e-03f },
+    { -1.603983401e-04f, 1.114171371e-02f, -6.706073135e-02f, 2.473909110e-01f, 8.507758379e-01f, -3.990084678e-02f, -3.851851448e-03f, 1.665471937e-03f },
+    { -2.155959082e-04f, 1.203204878e-02f, -7.286407053e-02f, 2.800234854e-01f, 8.334787488e-01f, -5.329075083e-02f, -3.650251892e-04f, 1.201184350e-03f },
+    { -2.758321352e-04f, 1.287638489e-02f, -7.845518738e-02f, 3.134731352e-01f, 8.138341308e-01f, -6.500834227e-02f, 2.758455696e-03f, 7.974056643e-04f },
+    { -3.389969643e-04f, 1.365586184e-02f, -8.375093341e-02f, 3.475830555e-01f, 7.919696569e-01f, -7.508996874e-02f, 5.519052036e-03f, 4.522678501e-04f },
+    { -4.025620874e-04f, 1.435033791e-02f, -8.866404742e-02f, 3.821872473e-01f, 7.680269480e-01f, -8.358250558e-02f, 7.921357639e-03f, 1.631669875e-04f },
+    { -4.635986406e-04f, 1.493855473e-02f, -9.310378134e-02f, 4.171111882e-01f, 7.421594262e-01f, -9.054239094e-02f, 9.973731823e-03f, -7.311115041e-05f },
+    { -5.188005161e-04f, 1.539831143e-02f, -9.697655588e-02f, 4.521729052e-01f, 7.145311236e-01f, -9.603454918e-02f, 1.168792509e-02f, -2.602899913e-04f },
+    { -5.645181518e-04f, 1.570674218e-02f, -1.001867577e-01f, 4.871848226e-01f, 6.853152514e-01f, -1.001316607e-01f, 1.307855640e-02f, -4.024825757e-04f },
+    { -5.967861507e-04f, 1.584049314e-02f, -1.026374474e-01f, 5.219547153e-01f, 6.546931863e-01f, -1.029129475e-01f, 1.416272763e-02f, -5.040768301e-04f },
+    { -6.113812560e-04f, 1.577605121e-02f, -1.042313576e-01f, 5.562871695e-01f, 6.228526831e-01f, -1.044631824e-01f, 1.495963428e-02f, -5.696499720e-04f },
+    { -6.038637948e-04f, 1.549006160e-02f, -1.048717126e-01f, 5.899855494e-01f, 5.899855494e-01f, -1.048717126e-01f, 1.549006160e-02f, -6.038637948e-04f },
+    { -5.696499720e-04f, 1.495963428e-02f, -1.044631824e-01f, 6.228526831e-01f, 5.562871695e-01f, -1.042313576e-01f, 1.577605121e-02f, -6.113812560e-04f },
+    { -5.040769465e-04f, 1.416273043e-02f, -1.029129699e-01f, 6.546933651e-01f, 5.219547749e-01f, -1.026374698e-01f, 1.584049687e-02f, -5.967862671e-04f },
+    { -4.024826048e-04f, 1.307855733e-02f, -1.001316682e-01f, 6.853153110e-01f, 4.871848822e-01f, -1.001867652e-01f, 1.570674405e-02f, -5.645182100e-04f },
+    { -2.602899622e-04f, 1.168792415e-02f, -9.603453428e-02f, 7.145310044e-01f, 4.521728456e-01f, -9.697654098e-02f, 1.539830957e-02f, -5.188004579e-04f },
+    { -7.311114314e-05f, 9.973730892e-03f, -9.054238349e-02f, 7.421593666e-01f, 4.171111584e-01f, -9.310377389e-02f, 1.493855286e-02f, -4.635985824e-04f },
+    { 1.631670020e-04f, 7.921358570e-03f, -8.358251303e-02f, 7.680270076e-01f, 3.821872771e-01f, -8.866405487e-02f, 1.435033977e-02f, -4.025621456e-04f },
+    { 4.522677918e-04f, 5.519051570e-03f, -7.508995384e-02f, 7.919695973e-01f, 3.475830257e-01f, -8.375092596e-02f, 1.365586091e-02f, -3.389969061e-04f },
+    { 7.974054897e-04f, 2.758455230e-03f, -6.500832736e-02f, 8.138339520e-01f, 3.134730756e-01f, -7.845517248e-02f, 1.287638210e-02f, -2.758320770e-04f },
+    { 1.201184350e-03f, -3.650251892e-04f, -5.329075083e-02f, 8.334787488e-01f, 2.800234854e-01f, -7.286407053e-02f, 1.203204878e-02f, -2.155959082e-04f },
+    { 1.665471704e-03f, -3.851850983e-03f, -3.990083933e-02f, 8.507757783e-01f, 2.473908812e-01f, -6.706072390e-02f, 1.114171278e-02f, -1.603983255e-04f },
+    { 2.191274194e-03f, -7.697864436e-03f, -2.481346764e-02f, 8.656114936e-01f, 2.157213688e-01f, -6.112366915e-02f, 1.022284757e-02f, -1.119290027e-04f },
+    { 2.778627677e-03f, -1.189395878e-02f, -8.015433326e-03f, 8.778877258e-01f, 1.851493865e-01f, -5.512640253e-02f, 9.291428141e-03f, -7.144641131e-05f },
+    { 3.426486161e-03f, -1.642582938e-02f, 1.049363241e-02f, 8.875229955e-01f, 1.557976007e-01f, -4.913688824e-02f, 8.361843415e-03f, -3.978814493e-05f },
+    { 4.132580478e-03f, -2.127353102e-02f, 3.070103005e-02f, 8.944523931e-01f, 1.277754307e-01f, -4.321738705e-02f, 7.446879055e-03f, -1.738066931e-05f },
+    { 4.893366713e-03f, -2.641132474e-02f, 5.258040503e-02f, 8.986290693e-01f, 1.011791080e-01f, -3.742421418e-02f, 6.557712331e-03f, -4.237626854e-06f },
+    { 5.703893024e-03f, -3.180751204e-02f, 7.609125972e-02f, 9.000247121e-01f, 7.609125972e-02f, -3.180751204e-02f, 5.703893024e-03f, 1.127790861e-09f },
+};
+
 void beeper_init(beeper_t* b, int tick_hz, int sound_hz, float magnitude) {
     CHIPS_ASSERT(b);
     CHIPS_ASSERT((tick_hz > 0) && (sound_hz > 0));
@@ -95,6 +189,29 @@ void beeper_reset(beeper_t* b) {
     b->state = 0;
     b->counter = b->period;
     b->sample = 0;
+    b->level = 0;
+    b->pending = 0;
+    b->ring_pos = 0;
+    memset(b->ring, 0, sizeof(b->ring));
+}
+
+void beeper_step_at(beeper_t* b, int tick, float delta) {
+    /* fixed-point ticks since the last sample, and the first sample after the step */
+    const int t = tick * BEEPER_FIXEDPOINT_SCALE - b->counter + b->period;
+    CHIPS_ASSERT(t >= 0);
+    int first = t / b->period;
+    if (first > BEEPER_BLEP_TAPS) {
+        first = BEEPER_BLEP_TAPS;
+    }
+    /* distance from the step to the first sample after it, in 1/BEEPER_BLEP_PHASES samples */
+    const int phase = ((b->period - (t % b->period)) * BEEPER_BLEP_PHASES) / b->period;
+    const float* blep = _beeper_blep[phase];
+    for (int k = 0; k < BEEPER_BLEP_TAPS; k++) {
+        b->ring[(b->ring_pos + first + k) & (BEEPER_BLEP_RING-1)] += delta * blep[k];
+    }
+    if (b->pending < (first + BEEPER_BLEP_TAPS)) {
+        b->pending = first + BEEPER_BLEP_TAPS;
+    }
 }
 
 #endif /* CHIPS_IMPL */
@@ -18,6 +18,14 @@
     ~~~
         your own assert macro (default: assert(c))
 
+    Define the following macro to make c64_exec() run a copy of
+    m6502_exec() with the tick function known at compile time (see the
+    'Compile-time tick callback' section in m6502.h):
+
+    ~~~C
+    CHIPS_INLINE_TICK
+    ~~~
+
     You need to include the following headers before including cpc.h:
 
     - chips/m6502.h
@@ -147,6 +155,7 @@ typedef struct {
     c64_audio_callback_t audio_cb;
     int num_samples;
     int sample_pos;
+    uint32_t sid_ticks;             /* SID ticks which haven't been rendered yet */
     float sample_buffer[C64_MAX_AUDIO_SAMPLES];
 
     uint8_t color_ram[1024];        /* special static color ram */
@@ -230,6 +239,19 @@ static void _c64_update_memory_map(c64_t* sys);
 static void _c64_init_key_map(c64_t* sys);
 static void _c64_init_memory_map(c64_t* sys);
 static bool _c64_tape_tick(c64_t* sys);
+static void _c64_sid_catchup(c64_t* sys);
+
+#ifdef CHIPS_INLINE_TICK
+/* an m6502_exec() copy which calls _c64_tick() directly, see _m6502_exec.h */
+#define M6502_EXEC_FUNC _c64_m6502_exec
+#define M6502_EXEC_TICK _c64_tick
+#include "_m6502_exec.h"
+#define _C64_M6502_EXEC _c64_m6502_exec
+#define _C64_M6510_IORQ _m6510_iorq
+#else
+#define _C64_M6502_EXEC m6502_exec
+#define _C64_M6510_IORQ m6510_iorq
+#endif
 
 #define _C64_DEFAULT(val,def) (((val) != 0) ? (val) : (def));
 #define _C64_CLEAR(val) memset(&val, 0, sizeof(val))
@@ -325,6 +347,7 @@ void c64_reset(c64_t* sys) {
     m6526_reset(&sys->cia_2);
     m6569_reset(&sys->vic);
     m6581_reset(&sys->sid);
+    sys->sid_ticks = 0;
     beeper_reset(&sys->beeper);
     sys->tape_motor = false;
     sys->tape_button = false;
@@ -336,7 +359,8 @@ void c64_reset(c64_t* sys) {
 void c64_exec(c64_t* sys, uint32_t micro_seconds) {
     CHIPS_ASSERT(sys && sys->valid);
     uint32_t ticks_to_run = clk_ticks_to_run(&sys->clk, micro_seconds);
-    uint32_t ticks_executed = m6502_exec(&sys->cpu, ticks_to_run);
+    uint32_t ticks_executed = _C64_M6502_EXEC(&sys->cpu, ticks_to_run);
+    _c64_sid_catchup(sys);
     clk_ticks_executed(&sys->clk, ticks_executed);
     kbd_update(&sys->kbd);
 }
@@ -426,21 +450,26 @@ static uint64_t _c64_tick(uint64_t pins, void* user_data) {
         beeper_tick(&sys->beeper);
     }
 
-    /* tick the SID */
-    if (m6581_tick(&sys->sid)) {
-        /* new audio sample ready */
-        float sample = sys->sid.sample;
-        if (sys->tape_motor) {
-            sample += sys->beeper.sample;
-        }
-        sys->sample_buffer[sys->sample_pos++] = sample;
-        if (sys->sample_pos == sys->num_samples) {
-            if (sys->audio_cb) {
-                sys->audio_cb(sys->sample_buffer, sys->num_samples, sys->user_data);
+    /* tick the SID, this is usually deferred to _c64_sid_catchup(),
+       but while the tape motor runs, the tape sound is mixed into
+       each sample so the SID needs to run in lockstep
+    */
+    if (sys->tape_motor) {
+        _c64_sid_catchup(sys);
+        if (m6581_tick(&sys->sid)) {
+            /* new audio sample ready */
+            sys->sample_buffer[sys->sample_pos++] = sys->sid.sample + sys->beeper.sample;
+            if (sys->sample_pos == sys->num_samples) {
+                if (sys->audio_cb) {
+                    sys->audio_cb(sys->sample_buffer, sys->num_samples, sys->user_data);
+                }
+                sys->sample_pos = 0;
             }
-            sys->sample_pos = 0;
         }
     }
+    else {
+        sys->sid_ticks++;
+    }
 
     /* tick the CIAs:
         - CIA-1 gets the FLAG pin from the datasette
@@ -480,7 +509,7 @@ static uint64_t _c64_tick(uint64_t pins, void* user_data) {
     /* handle IO requests */
     if (M6510_CHECK_IO(pins)) {
         /* ...the integrated IO port in the M6510 CPU at addresses 0 and 1 */
-        pins = m6510_iorq(&sys->cpu, pins);
+        pins = _C64_M6510_IORQ(&sys->cpu, pins);
     }
     else {
         /* ...the memory-mapped IO area from 0xD000 to 0xDFFF */
@@ -491,7 +520,8 @@ static uint64_t _c64_tick(uint64_t pins, void* user_data) {
                 pins = m6569_iorq(&sys->vic, vic_pins) & M6502_PIN_MASK;
             }
             else if (addr < 0xD800) {
-                /* SID (D400..D7FF) */
+                /* SID (D400..D7FF), bring the SID up to the current tick first */
+                _c64_sid_catchup(sys);
                 uint64_t sid_pins = (pins & M6502_PIN_MASK)|M6581_CS;
                 pins = m6581_iorq(&sys->sid, sid_pins) & M6502_PIN_MASK;
             }
@@ -860,6 +890,25 @@ void c64_stop_tape(c64_t* sys) {
     sys->tape_motor = false;
 }
 
+/* render the SID ticks which have been deferred since the last catch-up */
+static void _c64_sid_catchup(c64_t* sys) {
+    int max_samples, num_samples;
+    do {
+        max_samples = sys->num_samples - sys->sample_pos;
+        num_samples = m6581_render(&sys->sid, sys->sid_ticks, &sys->sample_buffer[sys->sample_pos], max_samples);
+        sys->sid_ticks = 0;
+        sys->sample_pos += num_samples;
+        if (sys->sample_pos == sys->num_samples) {
+            if (sys->audio_cb) {
+                /* new sample packet is ready */
+                sys->audio_cb(sys->sample_buffer, sys->num_samples, sys->user_data);
+            }
+            sys->sample_pos = 0;
+        }
+    }
+    while (num_samples == max_samples);
+}
+
 static bool _c64_tape_tick(c64_t* sys) {
     if (sys->tape_motor && (sys->tape_size > 0) && (sys->tape_pos <= sys->tape_size)) {
         if (sys->tape_tick_count == 0) {
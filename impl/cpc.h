@@ -18,10 +18,19 @@
     ~~~
         your own assert macro (default: assert(c))
 
+    Define the following macro to make cpc_exec() run a copy of
+    z80_exec() with the tick function known at compile time (see the
+    'Compile-time tick callback' section in z80.h):
+
+    ~~~C
+    CHIPS_INLINE_TICK
+    ~~~
+
     You need to include the following headers before including cpc.h:
 
     - chips/z80.h
     - chips/ay38910.h
+    - chips/resampler.h
     - chips/i8255.h
     - chips/mc6845.h
     - chips/crt.h
@@ -122,6 +131,8 @@ typedef struct {
     int audio_num_samples;          /* default is ZX_AUDIO_NUM_SAMPLES */
     int audio_sample_rate;          /* playback sample rate, default is 44100 */
     float audio_volume;             /* audio volume: 0.0..1.0, default is 0.25 */
+    float* audio_kernel_buffer;     /* optional: memory for the PSG resampler kernel to share between instances with the same sample rate */
+    int audio_kernel_buffer_size;   /* size of the kernel buffer in bytes, RESAMPLER_MAX_KERNEL_SIZE bytes are always enough */
 
     /* an optional callback to generate a video-decode debug visualization */
     cpc_video_debug_callback_t video_debug_cb;
@@ -166,6 +177,7 @@ typedef struct {
 typedef struct {
     z80_t cpu;
     ay38910_t psg;
+    resampler_t psg_resampler;      /* PSG native rate to audio sample rate */
     mc6845_t vdg;
     i8255_t ppi;
 
@@ -177,6 +189,7 @@ typedef struct {
     uint8_t joy_joymask;
     uint8_t upper_rom_select;
     uint32_t tick_count;
+    uint32_t psg_ticks;             /* PSG ticks which haven't been rendered yet */
     uint16_t casread_trap;
     uint16_t casread_ret;
     cpc_gatearray_t ga;
@@ -253,6 +266,11 @@ extern void cpc_ga_decode_pixels(cpc_t* sys, uint32_t* dst, uint64_t crtc_pins);
 
 #define _CPC_DISPLAY_SIZE (CPC_DISPLAY_WIDTH*CPC_DISPLAY_HEIGHT*4)
 #define _CPC_FREQUENCY (4000000)
+/* the PSG output only changes every 8 PSG ticks, sampling it at that
+   rate is exact, the resampler takes it from there to the audio rate
+*/
+#define _CPC_PSG_NATIVE_HZ (_CPC_FREQUENCY / 4 / 8)
+#define _CPC_PSG_CHUNK (256)
 
 static uint64_t _cpc_tick(int num, uint64_t pins, void* user_data);
 static uint64_t _cpc_cpu_iorq(cpc_t* sys, uint64_t pins);
@@ -260,6 +278,7 @@ static uint64_t _cpc_ppi_out(int port_id, uint64_t pins, uint8_t data, void* use
 static uint8_t _cpc_ppi_in(int port_id, void* user_data);
 static void _cpc_psg_out(int port_id, uint8_t data, void* user_data);
 static uint8_t _cpc_psg_in(int port_id, void* user_data);
+static void _cpc_psg_catchup(cpc_t* sys);
 static void _cpc_ga_init(cpc_t* sys);
 static uint64_t _cpc_ga_tick(cpc_t* sys, uint64_t pins);
 static void _cpc_ga_int_ack(cpc_t* sys);
@@ -268,6 +287,16 @@ static void _cpc_init_keymap(cpc_t* sys);
 static void _cpc_update_memory_mapping(cpc_t* sys);
 static void _cpc_casread(cpc_t* sys);
 
+#ifdef CHIPS_INLINE_TICK
+/* a z80_exec() copy which calls _cpc_tick() directly, see _z80_exec.h */
+#define Z80_EXEC_FUNC _cpc_z80_exec
+#define Z80_EXEC_TICK _cpc_tick
+#include "_z80_exec.h"
+#define _CPC_Z80_EXEC _cpc_z80_exec
+#else
+#define _CPC_Z80_EXEC z80_exec
+#endif
+
 #define _CPC_DEFAULT(val,def) (((val) != 0) ? (val) : (def));
 #define _CPC_CLEAR(val) memset(&val, 0, sizeof(val))
 
@@ -328,10 +357,18 @@ void cpc_init(cpc_t* sys, cpc_desc_t* desc) {
     psg_desc.in_cb = _cpc_psg_in;
     psg_desc.out_cb = _cpc_psg_out;
     psg_desc.tick_hz = _CPC_FREQUENCY / 4;
-    psg_desc.sound_hz = _CPC_DEFAULT(desc->audio_sample_rate, 44100);
+    psg_desc.sound_hz = _CPC_PSG_NATIVE_HZ;
     psg_desc.magnitude = _CPC_DEFAULT(desc->audio_volume, 0.7f);
     psg_desc.user_data = sys;
     ay38910_init(&sys->psg, &psg_desc);
+    resampler_desc_t rs_desc;
+    _CPC_CLEAR(rs_desc);
+    rs_desc.in_hz = _CPC_PSG_NATIVE_HZ;
+    rs_desc.out_hz = _CPC_DEFAULT(desc->audio_sample_rate, 44100);
+    rs_desc.kernel_buffer = desc->audio_kernel_buffer;
+    rs_desc.kernel_buffer_size = desc->audio_kernel_buffer_size;
+    CHIPS_ASSERT(rs_desc.out_hz <= rs_desc.in_hz);
+    resampler_init(&sys->psg_resampler, &rs_desc);
 
     mc6845_init(&sys->vdg, MC6845_TYPE_UM6845R);
     crt_init(&sys->crt, CRT_PAL, 6, 32, CPC_DISPLAY_WIDTH/16, CPC_DISPLAY_HEIGHT);
@@ -367,12 +404,14 @@ void cpc_reset(cpc_t* sys) {
     mc6845_reset(&sys->vdg);
     crt_reset(&sys->crt);
     ay38910_reset(&sys->psg);
+    resampler_reset(&sys->psg_resampler);
     i8255_reset(&sys->ppi);
     z80_reset(&sys->cpu);
     z80_set_pc(&sys->cpu, 0x0000);
     sys->kbd_joymask = 0;
     sys->joy_joymask = 0;
     sys->tick_count = 0;
+    sys->psg_ticks = 0;
     sys->upper_rom_select = 0;
     _cpc_ga_init(sys);
     mem_unmap_all(&sys->mem);
@@ -384,7 +423,7 @@ void cpc_exec(cpc_t* sys, uint32_t micro_seconds) {
     uint32_t ticks_to_run = clk_ticks_to_run(&sys->clk, micro_seconds);
     uint32_t ticks_executed = 0;
     while (ticks_executed < ticks_to_run) {
-        ticks_executed += z80_exec(&sys->cpu, ticks_to_run);
+        ticks_executed += _CPC_Z80_EXEC(&sys->cpu, ticks_to_run);
         /* check if casread trap has been hit, and the right ROM is mapped in */
         if (sys->cpu.trap_id == 1) {
             if (sys->type == CPC_TYPE_6128) {
@@ -398,6 +437,7 @@ void cpc_exec(cpc_t* sys, uint32_t micro_seconds) {
             }
         }
     }
+    _cpc_psg_catchup(sys);
     clk_ticks_executed(&sys->clk, ticks_executed);
     kbd_update(&sys->kbd);
 }
@@ -528,18 +568,8 @@ static uint64_t _cpc_tick(int num_ticks, uint64_t pins, void* user_data) {
             }
             /* on every 4th clock cycle, tick the system */
             if (!wait_pin) {
-                /* tick the sound generator */
-                if (ay38910_tick(&sys->psg)) {
-                    /* new sample is ready */
-                    sys->sample_buffer[sys->sample_pos++] = sys->psg.sample;
-                    if (sys->sample_pos == sys->num_samples) {
-                        if (sys->audio_cb) {
-                            /* new sample packet is ready */
-                            sys->audio_cb(sys->sample_buffer, sys->num_samples, sys->user_data);
-                        }
-                        sys->sample_pos = 0;
-                    }
-                }
+                /* the sound generator is only rendered when needed */
+                sys->psg_ticks++;
                 /* tick the gate array */
                 pins = _cpc_ga_tick(sys, pins);
             }
@@ -691,6 +721,7 @@ static uint64_t _cpc_ppi_out(int port_id, uint64_t pins, uint8_t data, void* use
             if (ay_ctrl & (1<<6)) { ay_pins |= AY38910_BC1; }
             const uint8_t ay_data = sys->ppi.output[I8255_PORT_A];
             AY38910_SET_DATA(ay_pins, ay_data);
+            _cpc_psg_catchup(sys);
             ay38910_iorq(&sys->psg, ay_pins);
         }
     }
@@ -789,6 +820,29 @@ static uint8_t _cpc_psg_in(int port_id, void* user_data) {
     }
 }
 
+/* render the PSG samples up to the current tick into the sample buffer */
+static void _cpc_psg_catchup(cpc_t* sys) {
+    float psg_samples[_CPC_PSG_CHUNK];
+    float samples[_CPC_PSG_CHUNK + 1];
+    int num_psg_samples;
+    do {
+        num_psg_samples = ay38910_render(&sys->psg, sys->psg_ticks, psg_samples, _CPC_PSG_CHUNK);
+        sys->psg_ticks = 0;
+        const int num_samples = resampler_process(&sys->psg_resampler, psg_samples, num_psg_samples, samples);
+        for (int i = 0; i < num_samples; i++) {
+            sys->sample_buffer[sys->sample_pos++] = samples[i];
+            if (sys->sample_pos == sys->num_samples) {
+                if (sys->audio_cb) {
+                    /* new sample packet is ready */
+                    sys->audio_cb(sys->sample_buffer, sys->num_samples, sys->user_data);
+                }
+                sys->sample_pos = 0;
+            }
+        }
+    }
+    while (num_psg_samples == _CPC_PSG_CHUNK);
+}
+
 /*=== GATE ARRAY STUFF =======================================================*/
 
 /* the first 32 bytes of the KC Compact color ROM */
@@ -658,28 +658,28 @@ static uint64_t _kc85_tick(int num_ticks, uint64_t pins, void* user_data) {
         pins = z80ctc_tick(&sys->ctc, pins);
         /* CTC channels 0 and 1 triggers control audio frequencies */
         if (pins & Z80CTC_ZCTO0) {
-            beeper_toggle(&sys->beeper_1);
+            beeper_toggle_at(&sys->beeper_1, i);
         }
         if (pins & Z80CTC_ZCTO1) {
-            beeper_toggle(&sys->beeper_2);
+            beeper_toggle_at(&sys->beeper_2, i);
         }
         /* CTC channel 2 trigger controls video blink frequency */
         if (pins & Z80CTC_ZCTO2) {
             sys->blink_flag = !sys->blink_flag;
         }
         pins &= Z80_PIN_MASK;
-        beeper_tick(&sys->beeper_1);
-        if (beeper_tick(&sys->beeper_2)) {
-            /* new audio sample ready */
-            sys->sample_buffer[sys->sample_pos++] = sys->beeper_1.sample + sys->beeper_2.sample;
-            if (sys->sample_pos == sys->num_samples) {
-                if (sys->audio_cb) {
-                    sys->audio_cb(sys->sample_buffer, sys->num_samples, sys->user_data);
-                }
-                sys->sample_pos = 0;
+    }
+    beeper_ticks(&sys->beeper_1, num_ticks);
+    if (beeper_ticks(&sys->beeper_2, num_ticks)) {
+        /* new audio sample ready */
+        sys->sample_buffer[sys->sample_pos++] = sys->beeper_1.sample + sys->beeper_2.sample;
+        if (sys->sample_pos == sys->num_samples) {
+            if (sys->audio_cb) {
+                sys->audio_cb(sys->sample_buffer, sys->num_samples, sys->user_data);
             }
+            sys->sample_pos = 0;
         }
-    }    
+    }
 
     /* memory and IO requests */
     if (pins & Z80_MREQ) {
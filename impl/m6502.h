@@ -116,6 +116,27 @@
     ~~~
         Clear the trap with number _trap_id_.
 
+    ## Compile-time tick callback
+
+    m6502_exec() calls the tick callback through the function pointer in
+    m6502_t on every clock cycle. An emulator can stamp out its own
+    static copy of m6502_exec() which calls its tick function directly
+    (and lets the compiler inline it) by including _m6502_exec.h in its
+    implementation part:
+
+    ~~~C
+    static uint64_t my_tick(uint64_t pins, void* user_data);
+    #define M6502_EXEC_FUNC my_m6502_exec
+    #define M6502_EXEC_TICK my_tick
+    #include "_m6502_exec.h"
+    ~~~
+
+    The system headers do this for their own tick function when
+    CHIPS_INLINE_TICK is defined, an m6510 tick function can call the
+    inline _m6510_iorq() instead of m6510_iorq() in that case. Each copy
+    adds a complete instruction decoder to the executable and to the
+    compile time.
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -474,7 +495,7 @@ bool m6502_has_trap(m6502_t* c, int trap_id) {
 }
 
 /* only call this when accessing address 0 or 1 (M6510_CHECK_IO(pins) evaluates to true) */
-uint64_t m6510_iorq(m6502_t* c, uint64_t pins) {
+static inline uint64_t _m6510_iorq(m6502_t* c, uint64_t pins) {
     CHIPS_ASSERT(c->in_cb && c->out_cb);
     if ((pins & M6502_A0) == 0) {
         /* address 0: access to data direction register */
@@ -505,4 +526,8 @@ uint64_t m6510_iorq(m6502_t* c, uint64_t pins) {
     }
     return pins;
 }
+
+uint64_t m6510_iorq(m6502_t* c, uint64_t pins) {
+    return _m6510_iorq(c, pins);
+}
 #endif /* CHIPS_IMPL */
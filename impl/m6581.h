@@ -35,6 +35,24 @@
 
     TODO: Documentation
 
+    ## Block Rendering
+
+    Instead of calling m6581_tick() on every chip clock, an emulator
+    can count the ticks the chip is behind, and only call m6581_render()
+    with that number of ticks before accessing a chip register via
+    m6581_iorq(), and when it needs a block of audio samples. This
+    keeps register accesses cycle-exact, and the output is identical
+    to calling m6581_tick() on every clock.
+
+    m6581_render() works on blocks of up to M6581_BLOCK_TICKS ticks: each
+    voice is run over the whole block with the waveform selected once per
+    block, and the filter runs over the summed voice outputs afterwards.
+    Voices which use hard sync or ring modulation depend on each other
+    in every tick, in that case the voices are ticked in lockstep.
+
+    When the sample buffer is full, the remaining ticks are kept and
+    rendered first by the next call.
+
     ## Links
 
     - http://blog.kevtris.org/?p=13
@@ -145,6 +163,9 @@ extern "C" {
 #define M6581_FILTER_HP     (1<<2)
 #define M6581_FILTER_3OFF   (1<<3)
 
+/* max number of ticks m6581_render() runs in one block */
+#define M6581_BLOCK_TICKS (64)
+
 /* setup parameters for m6581_init() */
 typedef struct {
     int tick_hz;        /* frequency at which m6581_tick() will be called in Hz */
@@ -218,6 +239,7 @@ typedef struct {
     float sample_accum_count;
     float sample_mag;
     float sample;
+    uint32_t pending_ticks;     /* ticks left over by m6581_render() when the buffer was full */
 } m6581_t;
 
 /* initialize a new m6581_t instance */
@@ -228,6 +250,8 @@ extern void m6581_reset(m6581_t* sid);
 extern uint64_t m6581_iorq(m6581_t* sid, uint64_t pins);
 /* tick a m6581_t instance, returns true when new sample is ready */
 extern bool m6581_tick(m6581_t* sid);
+/* advance the m6581 by num_ticks, write new samples to out, return number of samples written */
+extern int m6581_render(m6581_t* sid, uint32_t num_ticks, float* out, int max_samples);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -343,6 +367,7 @@ void m6581_reset(m6581_t* sid) {
     sid->sample = 0.0f;
     sid->sample_accum = 0.0f;
     sid->sample_accum_count = 1.0f;
+    sid->pending_ticks = 0;
 }
 
 /*--- VOICE IMPLEMENTATION ---------------------------------------------------*/
@@ -482,10 +507,8 @@ static inline uint16_t _m6581_noise(m6581_voice_t* v) {
            (M6581_BIT(s,2)<<4);
 }
 
-static inline void _m6581_voice_tick(m6581_t* sid, int voice_index) {
-    m6581_voice_t* v = &sid->voice[voice_index];
-
-    /* waveform generator */
+/* advance the frequency accumulator and noise shift register of a voice */
+static inline void _m6581_wave_tick(m6581_voice_t* v) {
     if (0 == (v->ctrl & M6581_CTRL_TEST)) {
         /* frequency accumulator */
         uint32_t prev_accum = v->wav_accum;
@@ -499,23 +522,25 @@ static inline void _m6581_voice_tick(m6581_t* sid, int voice_index) {
         /* sync state */
         v->sync = (v->wav_accum & 0x00800000) &  !(prev_accum & 0x00800000);
     }
-    m6581_voice_t* v_sync = &sid->voice[(voice_index+2)%3];
-    uint32_t sm;
-    switch ((v->ctrl>>4) & 0x0F) {
-        case 0: sm = _m6581_wavnone(v); break;
-        case 1: sm = _m6581_triangle(v, v_sync); break;
-        case 2: sm = _m6581_sawtooth(v); break;
-        case 3: sm = _m6581_trisaw(v, v_sync); break;
-        case 4: sm = _m6581_pulse(v); break;
-        case 5: sm = _m6581_tripulse(v, v_sync); break;
-        case 6: sm = _m6581_sawpulse(v); break;
-        case 7: sm = _m6581_trisawpulse(v, v_sync); break;
-        case 8: sm = _m6581_noise(v); break;
-        default: sm = 0; break;
+}
+
+static inline uint32_t _m6581_wave_output(m6581_voice_t* v, m6581_voice_t* v_sync, uint32_t wave) {
+    switch (wave) {
+        case 0: return _m6581_wavnone(v);
+        case 1: return _m6581_triangle(v, v_sync);
+        case 2: return _m6581_sawtooth(v);
+        case 3: return _m6581_trisaw(v, v_sync);
+        case 4: return _m6581_pulse(v);
+        case 5: return _m6581_tripulse(v, v_sync);
+        case 6: return _m6581_sawpulse(v);
+        case 7: return _m6581_trisawpulse(v, v_sync);
+        case 8: return _m6581_noise(v);
+        default: return 0;
     }
-    v->wav_output = sm;
+}
 
-    /* envelope generator */
+/* envelope generator */
+static inline void _m6581_env_tick(m6581_voice_t* v) {
     uint32_t lfsr = v->env_counter;
     if (lfsr != _m6581_rate_count_period[v->env_counter_compare & 0x0F]) {
         const uint32_t feedback = ((lfsr >> 14) ^ (lfsr >> 13)) & 1;
@@ -557,6 +582,14 @@ static inline void _m6581_voice_tick(m6581_t* sid, int voice_index) {
     }
 }
 
+static inline void _m6581_voice_tick(m6581_t* sid, int voice_index) {
+    m6581_voice_t* v = &sid->voice[voice_index];
+    m6581_voice_t* v_sync = &sid->voice[(voice_index+2)%3];
+    _m6581_wave_tick(v);
+    v->wav_output = _m6581_wave_output(v, v_sync, (v->ctrl>>4) & 0x0F);
+    _m6581_env_tick(v);
+}
+
 static inline void _m6581_voice_sync(m6581_t* sid, int voice_index) {
     m6581_voice_t* v = &sid->voice[voice_index];
     m6581_voice_t* v_sync = &sid->voice[(voice_index+2)%3];
@@ -629,16 +662,20 @@ static inline int _m6581_filter_output(m6581_filter_t* f, int vi) {
 }
 
 /*--- TICK FUNCTION ----------------------------------------------------------*/
-bool m6581_tick(m6581_t* sid) {
-    CHIPS_ASSERT(sid);
-
-    /* decay the last written register value */
+static inline void _m6581_bus_decay(m6581_t* sid, uint32_t num_ticks) {
     if (sid->bus_decay > 0) {
-        if (--sid->bus_decay == 0) {
+        if (num_ticks >= sid->bus_decay) {
+            sid->bus_decay = 0;
             sid->bus_value = 0;
         }
+        else {
+            sid->bus_decay -= num_ticks;
+        }
     }
+}
 
+/* tick all voices, and sum up the unfiltered and filtered voice output */
+static inline void _m6581_voices_tick(m6581_t* sid, int* sum_outp, int* sum_filtered_outp) {
     /* tick wave and envelope generators */
     for (int i = 0; i < 3; i++) {
         _m6581_voice_tick(sid, i);
@@ -648,37 +685,56 @@ bool m6581_tick(m6581_t* sid) {
         _m6581_voice_sync(sid, i);
     }
     /* filter */
-    int sum_filtered_outp = 0;
-    int sum_outp = 0;
+    *sum_filtered_outp = 0;
+    *sum_outp = 0;
     for (int i = 0; i < 3; i++) {
         m6581_voice_t* v = &sid->voice[i];
         int wav_out = (int) v->wav_output;
         int env_out = (int) v->env_cur_level;
         if (sid->filter.voices & (1<<i)) {
-            sum_filtered_outp += (wav_out - M6581_DCWAVE) * env_out + M6581_DCVOICE;
+            *sum_filtered_outp += (wav_out - M6581_DCWAVE) * env_out + M6581_DCVOICE;
         }
         else {
             if (v->muted) {
-                sum_outp += (0 - M6581_DCWAVE) * env_out + M6581_DCVOICE;
+                *sum_outp += (0 - M6581_DCWAVE) * env_out + M6581_DCVOICE;
             }
             else {
-                sum_outp += (wav_out - M6581_DCWAVE) * env_out + M6581_DCVOICE;
+                *sum_outp += (wav_out - M6581_DCWAVE) * env_out + M6581_DCVOICE;
             }
         }
     }
+}
+
+/* run the voice sums of one tick through the filter into the sample accumulator */
+static inline void _m6581_mix(m6581_t* sid, int sum_outp, int sum_filtered_outp) {
     int accu = (sum_outp + _m6581_filter_output(&sid->filter, sum_filtered_outp) + M6581_DCMIXER) * sid->filter.volume;
     int sample = accu / (1<<12);
     sid->sample_accum += (sample / 16384.0f);
     sid->sample_accum_count += 1.0f;
+}
+
+static inline void _m6581_new_sample(m6581_t* sid) {
+    sid->sample_counter += sid->sample_period;
+    float s = sid->sample_accum / sid->sample_accum_count;
+    sid->sample = sid->sample_mag * s;
+    sid->sample_accum = 0.0f;
+    sid->sample_accum_count = 0.0f;
+}
+
+bool m6581_tick(m6581_t* sid) {
+    CHIPS_ASSERT(sid);
+
+    /* decay the last written register value */
+    _m6581_bus_decay(sid, 1);
+
+    int sum_outp, sum_filtered_outp;
+    _m6581_voices_tick(sid, &sum_outp, &sum_filtered_outp);
+    _m6581_mix(sid, sum_outp, sum_filtered_outp);
 
     /* new sample? */
     sid->sample_counter -= M6581_FIXEDPOINT_SCALE;
     if (sid->sample_counter <= 0) {
-        sid->sample_counter += sid->sample_period;
-        float s = sid->sample_accum / sid->sample_accum_count;
-        sid->sample = sid->sample_mag * s;
-        sid->sample_accum = 0.0f;
-        sid->sample_accum_count = 0.0f;
+        _m6581_new_sample(sid);
         return true;
     }
     else {
@@ -686,6 +742,99 @@ bool m6581_tick(m6581_t* sid) {
     }
 }
 
+/*--- BLOCK RENDERING --------------------------------------------------------*/
+/*
+    Runs a voice for num_ticks ticks and writes the voice output for each
+    tick into out[]. The waveform can't change within a block, so the
+    waveform switch is resolved once per block instead of once per tick.
+    The voice must not depend on its sync source (no ring modulation and
+    no hard sync), which allows running the 3 voices one after another.
+    The wav_mask is 0 for a muted voice which isn't routed through the
+    filter, otherwise all bits set.
+*/
+#define _M6581_VOICE_BLOCK(wave) \
+    for (uint32_t i = 0; i < num_ticks; i++) { \
+        _m6581_wave_tick(v); \
+        sm = _m6581_wave_output(v, v, wave); \
+        _m6581_env_tick(v); \
+        out[i] = ((int)(sm & wav_mask) - M6581_DCWAVE) * (int)v->env_cur_level + M6581_DCVOICE; \
+    }
+
+static void _m6581_voice_block(m6581_voice_t* v, uint32_t num_ticks, uint32_t wav_mask, int* out) {
+    uint32_t sm = v->wav_output;
+    switch ((v->ctrl>>4) & 0x0F) {
+        case 0: _M6581_VOICE_BLOCK(0); break;
+        case 1: _M6581_VOICE_BLOCK(1); break;
+        case 2: _M6581_VOICE_BLOCK(2); break;
+        case 3: _M6581_VOICE_BLOCK(3); break;
+        case 4: _M6581_VOICE_BLOCK(4); break;
+        case 5: _M6581_VOICE_BLOCK(5); break;
+        case 6: _M6581_VOICE_BLOCK(6); break;
+        case 7: _M6581_VOICE_BLOCK(7); break;
+        case 8: _M6581_VOICE_BLOCK(8); break;
+        default: _M6581_VOICE_BLOCK(9); break;
+    }
+    v->wav_output = sm;
+}
+#undef _M6581_VOICE_BLOCK
+
+static void _m6581_block(m6581_t* sid, uint32_t num_ticks) {
+    _m6581_bus_decay(sid, num_ticks);
+    const uint8_t ctrl = sid->voice[0].ctrl | sid->voice[1].ctrl | sid->voice[2].ctrl;
+    if (ctrl & (M6581_CTRL_SYNC|M6581_CTRL_RINGMOD)) {
+        /* voices depend on each other, tick them in lockstep */
+        for (uint32_t i = 0; i < num_ticks; i++) {
+            int sum_outp, sum_filtered_outp;
+            _m6581_voices_tick(sid, &sum_outp, &sum_filtered_outp);
+            _m6581_mix(sid, sum_outp, sum_filtered_outp);
+        }
+    }
+    else {
+        /* run each voice over the whole block, then mix and filter */
+        int out[3][M6581_BLOCK_TICKS];
+        int filt_mask[3];
+        for (int v = 0; v < 3; v++) {
+            const bool filtered = 0 != (sid->filter.voices & (1<<v));
+            const uint32_t wav_mask = (sid->voice[v].muted && !filtered) ? 0 : ~0U;
+            _m6581_voice_block(&sid->voice[v], num_ticks, wav_mask, out[v]);
+            filt_mask[v] = filtered ? ~0 : 0;
+        }
+        for (uint32_t i = 0; i < num_ticks; i++) {
+            const int o0 = out[0][i], o1 = out[1][i], o2 = out[2][i];
+            const int sum_filtered_outp = (o0 & filt_mask[0]) + (o1 & filt_mask[1]) + (o2 & filt_mask[2]);
+            const int sum_outp = (o0 & ~filt_mask[0]) + (o1 & ~filt_mask[1]) + (o2 & ~filt_mask[2]);
+            _m6581_mix(sid, sum_outp, sum_filtered_outp);
+        }
+    }
+    sid->sample_counter -= (int)num_ticks * M6581_FIXEDPOINT_SCALE;
+}
+
+int m6581_render(m6581_t* sid, uint32_t num_ticks, float* out, int max_samples) {
+    CHIPS_ASSERT(sid && out && (max_samples >= 0));
+    num_ticks += sid->pending_ticks;
+    sid->pending_ticks = 0;
+    int num_samples = 0;
+    while (num_ticks > 0) {
+        /* ticks until the next sample, a block ends at the latest right on the sample */
+        const uint32_t to_sample = (sid->sample_counter + M6581_FIXEDPOINT_SCALE - 1) / M6581_FIXEDPOINT_SCALE;
+        uint32_t n = (to_sample < M6581_BLOCK_TICKS) ? to_sample : M6581_BLOCK_TICKS;
+        if ((n == to_sample) && (n <= num_ticks) && (num_samples == max_samples)) {
+            /* out of buffer space, stop right before the sample */
+            n--;
+            sid->pending_ticks = num_ticks - n;
+            num_ticks = n;
+        }
+        n = (num_ticks < n) ? num_ticks : n;
+        num_ticks -= n;
+        _m6581_block(sid, n);
+        if (sid->sample_counter <= 0) {
+            _m6581_new_sample(sid);
+            out[num_samples++] = sid->sample;
+        }
+    }
+    return num_samples;
+}
+
 uint64_t m6581_iorq(m6581_t* sid, uint64_t pins) {
     CHIPS_ASSERT(sid);
     if (pins & M6581_CS) {
@@ -0,0 +1,251 @@
+#pragma once
+/*
+    resampler.h -- windowed-sinc sample rate converter
+
+    Converts a stream of samples from a chip's native output rate (for
+    instance the AY-3-8910 tone rate of tick_hz/8, where the chip output
+    is exact) to the audio playback rate. This replaces point-sampling the
+    chip state at the playback rate, which folds all tone harmonics above
+    half the playback rate back into the audible range.
+
+    The converter is a polyphase FIR filter: a Blackman-windowed sinc
+    with the cutoff at 0.45 times the lower of the two rates is stored
+    for RESAMPLER_PHASES sub-sample positions. Each output sample is the
+    dot product of the last input samples with the kernel for its
+    position, linearly interpolated between the two nearest stored ones. The filter length is
+    chosen so that the kernel has RESAMPLER_ZERO_CROSSINGS zero crossings
+    on each side (at most RESAMPLER_MAX_TAPS input samples), the output
+    is delayed by half the filter length.
+
+    The output rate is kept exact: the position of the next output sample
+    is tracked as whole input samples plus a remainder in 1/out_hz units,
+    so there is no drift from rounding a fixed-point step.
+
+    Only the ratio of in_hz to out_hz is used, so the rates can be given
+    in any common unit, for instance as the sample periods of the output
+    and input in clock ticks (note the swapped order). Exact periods keep
+    the output sample count exactly in step with another sample source
+    running off the same clock.
+
+    By default the filter kernel is stored in the resampler instance.
+    Optionally it can live in memory provided by the caller instead
+    (resampler_kernel_size() bytes for the given rates,
+    RESAMPLER_MAX_KERNEL_SIZE bytes are always enough), a buffer which is
+    too small is ignored. The kernel is only written by resampler_init(),
+    so instances with the same rate ratio can share one kernel buffer, as
+    long as they are not initialized concurrently.
+
+    Usage:
+
+    ~~~C
+    resampler_desc_t desc = { .in_hz = 125000, .out_hz = 44100 };
+    resampler_init(&r, &desc);
+    ...
+    // out must have room for resampler_max_out(&r, num_in) samples
+    int num_out = resampler_process(&r, in, num_in, out);
+    ~~~
+
+    ## zlib/libpng license
+
+    Copyright (c) 2018 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* number of stored sub-sample positions of the filter kernel */
+#define RESAMPLER_PHASES (32)
+/* sinc zero crossings on each side of the kernel center */
+#define RESAMPLER_ZERO_CROSSINGS (8)
+/* max filter length in input samples (must be a multiple of 4) */
+#define RESAMPLER_MAX_TAPS (128)
+/* kernel buffer size in bytes which is enough for any rates */
+#define RESAMPLER_MAX_KERNEL_SIZE ((RESAMPLER_PHASES+1)*RESAMPLER_MAX_TAPS*4)
+
+/* setup parameters for resampler_init() */
+typedef struct {
+    int in_hz;                  /* input sample rate */
+    int out_hz;                 /* output sample rate */
+    float* kernel_buffer;       /* optional shared memory for the filter kernel */
+    int kernel_buffer_size;     /* size of the kernel buffer in bytes, at least resampler_kernel_size() */
+} resampler_desc_t;
+
+/* resampler state */
+typedef struct {
+    int in_hz;
+    int out_hz;
+    int taps;           /* filter length in input samples (multiple of 4) */
+    int step;           /* whole input samples per output sample */
+    int step_frac;      /* remainder of the step in 1/out_hz */
+    int wait;           /* input samples until the next output sample */
+    int frac;           /* sub-sample position of the next output sample in 1/out_hz */
+    int hist_pos;
+    float sample;       /* last output sample */
+    /* the last input samples, stored twice so the filter window is contiguous */
+    float hist[2*RESAMPLER_MAX_TAPS];
+    /* RESAMPLER_PHASES+1 rows of taps coefficients in the kernel buffer or kernel_storage */
+    const float* kernel;
+    float kernel_storage[RESAMPLER_MAX_KERNEL_SIZE / 4];
+} resampler_t;
+
+/* size of the kernel buffer in bytes needed for the rates in desc */
+extern int resampler_kernel_size(const resampler_desc_t* desc);
+/* initialize a new resampler instance */
+extern void resampler_init(resampler_t* r, const resampler_desc_t* desc);
+/* reset the resampler instance */
+extern void resampler_reset(resampler_t* r);
+/* max number of output samples written by resampler_process() for num_in input samples */
+extern int resampler_max_out(const resampler_t* r, int num_in);
+/* convert num_in input samples, write output samples to out, return number of samples written */
+extern int resampler_process(resampler_t* r, const float* in, int num_in, float* out);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_IMPL
+#include <string.h>
+#include <math.h>   /* sinf, cosf, ceilf */
+#ifndef CHIPS_DEBUG
+    #ifdef _DEBUG
+        #define CHIPS_DEBUG
+    #endif
+#endif
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+#define _RESAMPLER_PI (3.14159265358979f)
+
+static float _resampler_cutoff(int in_hz, int out_hz) {
+    const float rate = (out_hz < in_hz) ? ((float)out_hz / in_hz) : 1.0f;
+    return 0.9f * rate;
+}
+
+/* filter length in input samples for the given rates */
+static int _resampler_taps(int in_hz, int out_hz) {
+    int taps = 2 * (int)ceilf(RESAMPLER_ZERO_CROSSINGS / _resampler_cutoff(in_hz, out_hz));
+    taps = (taps + 3) & ~3;
+    return (taps < RESAMPLER_MAX_TAPS) ? taps : RESAMPLER_MAX_TAPS;
+}
+
+/* Blackman-windowed sinc, one row per sub-sample position, each row sums to 1 */
+static void _resampler_init_kernel(resampler_t* r, float* kernel) {
+    const float cutoff = _resampler_cutoff(r->in_hz, r->out_hz);
+    const float half = r->taps / 2;
+    for (int p = 0; p <= RESAMPLER_PHASES; p++) {
+        float* row = &kernel[p * r->taps];
+        float sum = 0.0f;
+        for (int k = 0; k < r->taps; k++) {
+            /* distance of input sample k from the output position */
+            const float x = k - (half - 1.0f) - ((float)p / RESAMPLER_PHASES);
+            const float w = 0.42f + 0.5f*cosf(_RESAMPLER_PI*x/half) + 0.08f*cosf(2.0f*_RESAMPLER_PI*x/half);
+            const float sinc = (x == 0.0f) ? 1.0f : sinf(_RESAMPLER_PI*cutoff*x)/(_RESAMPLER_PI*cutoff*x);
+            row[k] = w * sinc;
+            sum += row[k];
+        }
+        for (int k = 0; k < r->taps; k++) {
+            row[k] /= sum;
+        }
+    }
+    r->kernel = kernel;
+}
+
+int resampler_kernel_size(const resampler_desc_t* desc) {
+    CHIPS_ASSERT(desc && (desc->in_hz > 0) && (desc->out_hz > 0));
+    return (RESAMPLER_PHASES+1) * _resampler_taps(desc->in_hz, desc->out_hz) * (int)sizeof(float);
+}
+
+void resampler_init(resampler_t* r, const resampler_desc_t* desc) {
+    CHIPS_ASSERT(r && desc);
+    CHIPS_ASSERT((desc->in_hz > 0) && (desc->out_hz > 0));
+    memset(r, 0, sizeof(*r));
+    r->in_hz = desc->in_hz;
+    r->out_hz = desc->out_hz;
+    r->step = r->in_hz / r->out_hz;
+    r->step_frac = r->in_hz % r->out_hz;
+    r->taps = _resampler_taps(r->in_hz, r->out_hz);
+    const bool use_buffer = desc->kernel_buffer && (desc->kernel_buffer_size >= resampler_kernel_size(desc));
+    _resampler_init_kernel(r, use_buffer ? desc->kernel_buffer : r->kernel_storage);
+    resampler_reset(r);
+}
+
+void resampler_reset(resampler_t* r) {
+    CHIPS_ASSERT(r);
+    r->wait = 1;
+    r->frac = 0;
+    r->hist_pos = 0;
+    r->sample = 0.0f;
+    memset(r->hist, 0, sizeof(r->hist));
+}
+
+int resampler_max_out(const resampler_t* r, int num_in) {
+    CHIPS_ASSERT(r && (num_in >= 0));
+    return (int)(((int64_t)num_in * r->out_hz) / r->in_hz) + 1;
+}
+
+/* filter the window x with the kernel interpolated between h0 and h1 at t,
+   the 4 independent sums are written so that the compiler can map them
+   to SIMD lanes
+*/
+static inline float _resampler_dot(const float* h0, const float* h1, float t, const float* x, int taps) {
+    float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+    for (int k = 0; k < taps; k += 4) {
+        s0 += (h0[k+0] + t * (h1[k+0] - h0[k+0])) * x[k+0];
+        s1 += (h0[k+1] + t * (h1[k+1] - h0[k+1])) * x[k+1];
+        s2 += (h0[k+2] + t * (h1[k+2] - h0[k+2])) * x[k+2];
+        s3 += (h0[k+3] + t * (h1[k+3] - h0[k+3])) * x[k+3];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+int resampler_process(resampler_t* r, const float* in, int num_in, float* out) {
+    CHIPS_ASSERT(r && in && out && (num_in >= 0));
+    int num_out = 0;
+    for (int i = 0; i < num_in; i++) {
+        r->hist[r->hist_pos] = r->hist[r->hist_pos + r->taps] = in[i];
+        if (++r->hist_pos == r->taps) {
+            r->hist_pos = 0;
+        }
+        if (--r->wait == 0) {
+            /* the filter window, oldest input sample first */
+            const float* x = &r->hist[r->hist_pos];
+            do {
+                const float pos = ((float)r->frac * RESAMPLER_PHASES) / r->out_hz;
+                const int p = (int)pos;
+                const float* h0 = &r->kernel[p * r->taps];
+                r->sample = _resampler_dot(h0, h0 + r->taps, pos - p, x, r->taps);
+                out[num_out++] = r->sample;
+                /* advance to the position of the next output sample */
+                r->wait = r->step;
+                r->frac += r->step_frac;
+                if (r->frac >= r->out_hz) {
+                    r->frac -= r->out_hz;
+                    r->wait++;
+                }
+            }
+            while (r->wait == 0);
+        }
+    }
+    return num_out;
+}
+
+#endif /* CHIPS_IMPL */
@@ -90,6 +90,9 @@
         main thread to the audio streaming thread in order to decouple the
         rate at which the main thread provides new audio data, and the
         streaming thread consuming audio data.
+        Packets are handed between the two threads through lock-free
+        single-producer/single-consumer queues, so neither thread ever
+        has to wait for the other.
 
     WORKING WITH SOKOL AUDIO
     ========================
@@ -242,6 +245,28 @@
             }
         }
 
+    To avoid the copy from your own sample buffer into the packet queue,
+    the samples can also be written directly into the packet memory:
+    saudio_begin_write() returns a pointer into the current packet and
+    the number of frames which can be written there, and
+    saudio_end_write() commits the frames actually written. The returned
+    range ends at the packet boundary, so loop until all frames are
+    written, or until saudio_begin_write() returns a null pointer because
+    the packet queue is full (all written frames must be committed before
+    the next call to saudio_begin_write() or saudio_push()):
+
+        // my_render() writes up to max_frames frames and returns the
+        // number of frames written, less than max_frames once it's done
+        int num_frames;
+        float* ptr;
+        while ((ptr = saudio_begin_write(&num_frames))) {
+            const int n = my_render(ptr, num_frames);
+            saudio_end_write(n);
+            if (n < num_frames) {
+                break;
+            }
+        }
+
     THE WEBAUDIO BACKEND
     ====================
     The WebAudio backend is currently using a ScriptProcessorNode callback to
@@ -269,9 +294,6 @@
     Since the CoreAudio API is implemented in C (not Objective-C) the
     implementation part of Sokol Audio can be included into a C source file.
 
-    For thread synchronisation, the CoreAudio backend will use the
-    pthread_mutex_* functions.
-
     The incoming floating point samples will be directly forwarded to
     CoreAudio without further conversion.
 
@@ -283,8 +305,6 @@
     The WASAPI backend is automatically selected when compiling on Windows
     (_WIN32 is defined).
 
-    For thread synchronisation a Win32 critical section is used.
-
     WASAPI may use a different size for its own streaming buffer then requested,
     so the base latency may be slightly bigger. The current backend implementation
     convertes the incoming floating point sample values to signed 16-bit
@@ -299,8 +319,6 @@
     The ALSA backend is automatically selected when compiling on Linux
     ('linux' is defined).
 
-    For thread synchronisation, the pthread_mutex_* functions are used.
-
     Samples are directly forwarded to ALSA in 32-bit float format, no
     further conversion is taking place.
 
@@ -370,6 +388,10 @@ SOKOL_API_DECL int saudio_channels(void);
 SOKOL_API_DECL int saudio_expect(void);
 /* push sample frames from main thread, returns number of frames actually pushed */
 SOKOL_API_DECL int saudio_push(const float* frames, int num_frames);
+/* get a pointer to write up to *num_frames sample frames directly into the packet queue, returns 0 if the queue is full */
+SOKOL_API_DECL float* saudio_begin_write(int* num_frames);
+/* commit frames written to the pointer returned by saudio_begin_write() */
+SOKOL_API_DECL void saudio_end_write(int num_frames);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -428,73 +450,63 @@ SOKOL_API_DECL int saudio_push(const float* frames, int num_frames);
 #define _SAUDIO_DEFAULT_NUM_PACKETS ((_SAUDIO_DEFAULT_BUFFER_FRAMES/_SAUDIO_DEFAULT_PACKET_FRAMES)*4)
 #define _SAUDIO_RING_MAX_SLOTS (128)
 
-/*--- mutex wrappers ---------------------------------------------------------*/
+#define _SAUDIO_CACHE_LINE (64)
+
+/*--- platform includes ------------------------------------------------------*/
 #if defined(__APPLE__) || defined(linux)
 #include "pthread.h"
-static pthread_mutex_t _saudio_mutex;
-
-_SOKOL_PRIVATE void _saudio_mutex_init(void) {
-    pthread_mutexattr_t attr;
-    pthread_mutexattr_init(&attr);
-    pthread_mutex_init(&_saudio_mutex, &attr);
-}
-
-_SOKOL_PRIVATE void _saudio_mutex_destroy(void) {
-    pthread_mutex_destroy(&_saudio_mutex);
-}
-
-_SOKOL_PRIVATE void _saudio_mutex_lock(void) {
-    pthread_mutex_lock(&_saudio_mutex);
-}
-
-_SOKOL_PRIVATE void _saudio_mutex_unlock(void) {
-    pthread_mutex_unlock(&_saudio_mutex);
-}
 #elif defined(_WIN32)
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
 #endif
 #include <windows.h>
-#include <synchapi.h>
 #pragma comment (lib, "kernel32.lib")
 #pragma comment (lib, "ole32.lib")
+#endif
 
-CRITICAL_SECTION _saudio_crit;
-
-_SOKOL_PRIVATE void _saudio_mutex_init(void) {
-    InitializeCriticalSection(&_saudio_crit);
+/*--- atomic wrappers --------------------------------------------------------*/
+/* NOTE: only aligned int loads and stores with acquire/release ordering are
+    needed for the single-producer/single-consumer queues below, on MSVC the
+    Interlocked functions are used since plain volatile accesses only have
+    these semantics with /volatile:ms (which isn't the default on ARM)
+*/
+#if defined(_MSC_VER)
+_SOKOL_PRIVATE int _saudio_load_acquire(int* ptr) {
+    return (int) InterlockedCompareExchange((volatile LONG*)ptr, 0, 0);
 }
 
-_SOKOL_PRIVATE void _saudio_mutex_destroy(void) {
-    DeleteCriticalSection(&_saudio_crit);
+_SOKOL_PRIVATE void _saudio_store_release(int* ptr, int val) {
+    InterlockedExchange((volatile LONG*)ptr, (LONG)val);
 }
-
-_SOKOL_PRIVATE void _saudio_mutex_lock(void) {
-    EnterCriticalSection(&_saudio_crit);
+#else
+_SOKOL_PRIVATE int _saudio_load_acquire(int* ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
 }
 
-_SOKOL_PRIVATE void _saudio_mutex_unlock(void) {
-    LeaveCriticalSection(&_saudio_crit);
+_SOKOL_PRIVATE void _saudio_store_release(int* ptr, int val) {
+    __atomic_store_n(ptr, val, __ATOMIC_RELEASE);
 }
-#else
-_SOKOL_PRIVATE void _saudio_mutex_init(void) { }
-_SOKOL_PRIVATE void _saudio_mutex_destroy(void) { }
-_SOKOL_PRIVATE void _saudio_mutex_lock(void) { }
-_SOKOL_PRIVATE void _saudio_mutex_unlock(void) { }
 #endif
 
-/*--- a ring-buffer queue implementation -------------------------------------*/
+/*--- a lock-free single-producer/single-consumer ring-buffer queue ----------*/
+/* head is only written by the enqueueing thread, tail only by the dequeueing
+    thread, each on its own cache line so that the two threads don't
+    invalidate each other's cache lines on every operation
+*/
 typedef struct {
     int head;  /* next slot to write to */
+    uint8_t pad0[_SAUDIO_CACHE_LINE - sizeof(int)];
     int tail;  /* next slot to read from */
+    uint8_t pad1[_SAUDIO_CACHE_LINE - sizeof(int)];
     int num;   /* number of slots in queue */
     int queue[_SAUDIO_RING_MAX_SLOTS];
 } _saudio_ring;
 
-_SOKOL_PRIVATE uint16_t _saudio_ring_idx(_saudio_ring* ring, int i) {
-    return (uint16_t) (i % ring->num);
+_SOKOL_PRIVATE int _saudio_ring_idx(_saudio_ring* ring, int i) {
+    return (i == ring->num) ? 0 : i;
 }
 
+/* NOTE: not thread-safe, must be called before the queue is shared */
 _SOKOL_PRIVATE void _saudio_ring_init(_saudio_ring* ring, int num_slots) {
     SOKOL_ASSERT((num_slots + 1) <= _SAUDIO_RING_MAX_SLOTS);
     ring->head = 0;
@@ -504,42 +516,56 @@ _SOKOL_PRIVATE void _saudio_ring_init(_saudio_ring* ring, int num_slots) {
     memset(ring->queue, 0, sizeof(ring->queue));
 }
 
-_SOKOL_PRIVATE bool _saudio_ring_full(_saudio_ring* ring) {
-    return _saudio_ring_idx(ring, ring->head + 1) == ring->tail;
-}
-
-_SOKOL_PRIVATE bool _saudio_ring_empty(_saudio_ring* ring) {
-    return ring->head == ring->tail;
-}
-
+/* number of queued items, exact when called from the dequeueing thread
+    (more items may be added concurrently), a lower bound of free slots
+    when called from the enqueueing thread
+*/
 _SOKOL_PRIVATE int _saudio_ring_count(_saudio_ring* ring) {
+    const int head = _saudio_load_acquire(&ring->head);
+    const int tail = _saudio_load_acquire(&ring->tail);
     int count;
-    if (ring->head >= ring->tail) {
-        count = ring->head - ring->tail;
+    if (head >= tail) {
+        count = head - tail;
     }
     else {
-        count = (ring->head + ring->num) - ring->tail;
+        count = (head + ring->num) - tail;
     }
     SOKOL_ASSERT((count >= 0) && (count < ring->num));
     return count;
 }
 
-_SOKOL_PRIVATE void _saudio_ring_enqueue(_saudio_ring* ring, int val) {
-    SOKOL_ASSERT(!_saudio_ring_full(ring));
-    ring->queue[ring->head] = val;
-    ring->head = _saudio_ring_idx(ring, ring->head + 1);
+/* called from the enqueueing thread, returns false if the queue is full */
+_SOKOL_PRIVATE bool _saudio_ring_enqueue(_saudio_ring* ring, int val) {
+    const int head = ring->head;
+    const int next = _saudio_ring_idx(ring, head + 1);
+    if (next == _saudio_load_acquire(&ring->tail)) {
+        return false;
+    }
+    ring->queue[head] = val;
+    _saudio_store_release(&ring->head, next);
+    return true;
 }
 
-_SOKOL_PRIVATE int _saudio_ring_dequeue(_saudio_ring* ring) {
-    SOKOL_ASSERT(!_saudio_ring_empty(ring));
-    int val = ring->queue[ring->tail];
-    ring->tail = _saudio_ring_idx(ring, ring->tail + 1);
-    return val;
+/* called from the dequeueing thread, returns false if the queue is empty */
+_SOKOL_PRIVATE bool _saudio_ring_dequeue(_saudio_ring* ring, int* val) {
+    const int tail = ring->tail;
+    if (tail == _saudio_load_acquire(&ring->head)) {
+        return false;
+    }
+    *val = ring->queue[tail];
+    _saudio_store_release(&ring->tail, _saudio_ring_idx(ring, tail + 1));
+    return true;
 }
 
 /*---  a packet fifo for queueing audio data from main thread ----------------*/
+/* The main thread takes empty packets from the write queue and puts them
+    into the read queue when full, the streaming thread takes full packets
+    from the read queue and puts them back into the write queue when done.
+    Each queue thus has exactly one producer and one consumer thread and
+    needs no lock, so pushing never waits on the streaming thread.
+*/
 typedef struct {
-    bool valid;
+    int valid;                  /* written last in _saudio_fifo_init() (with release semantics) */
     int packet_size;            /* size of a single packets in bytes(!) */
     int num_packets;            /* number of packet in fifo */
     uint8_t* base_ptr;          /* packet memory chunk base pointer (dynamically allocated) */
@@ -552,11 +578,11 @@ typedef struct {
 _SOKOL_PRIVATE void _saudio_fifo_init(_saudio_fifo* fifo, int packet_size, int num_packets) {
     /* NOTE: there's a chicken-egg situation during the init phase where the
         streaming thread must be started before the fifo is actually initialized,
-        thus the fifo init must already be protected from access by the fifo_read() func.
+        fifo_read() ignores the fifo until the valid flag is set at the end
+        (the fifo struct itself has been cleared in saudio_setup())
     */
-    _saudio_mutex_lock();
     SOKOL_ASSERT((packet_size > 0) && (num_packets > 0));
-    memset(fifo, 0, sizeof(_saudio_fifo));
+    SOKOL_ASSERT(!fifo->valid);
     fifo->packet_size = packet_size;
     fifo->num_packets = num_packets;
     fifo->base_ptr = (uint8_t*) SOKOL_MALLOC(packet_size * num_packets);
@@ -568,32 +594,62 @@ _SOKOL_PRIVATE void _saudio_fifo_init(_saudio_fifo* fifo, int packet_size, int n
     for (int i = 0; i < num_packets; i++) {
         _saudio_ring_enqueue(&fifo->write_queue, i);
     }
-    SOKOL_ASSERT(_saudio_ring_full(&fifo->write_queue));
     SOKOL_ASSERT(_saudio_ring_count(&fifo->write_queue) == num_packets);
-    SOKOL_ASSERT(_saudio_ring_empty(&fifo->read_queue));
     SOKOL_ASSERT(_saudio_ring_count(&fifo->read_queue) == 0);
-    fifo->valid = true;
-    _saudio_mutex_unlock();
+    _saudio_store_release(&fifo->valid, 1);
 }
 
 _SOKOL_PRIVATE void _saudio_fifo_shutdown(_saudio_fifo* fifo) {
     SOKOL_ASSERT(fifo->base_ptr);
     SOKOL_FREE(fifo->base_ptr);
     fifo->base_ptr = 0;
-    fifo->valid = false;
+    fifo->valid = 0;
 }
 
 _SOKOL_PRIVATE int _saudio_fifo_writable_bytes(_saudio_fifo* fifo) {
-    _saudio_mutex_lock();
     int num_bytes = (_saudio_ring_count(&fifo->write_queue) * fifo->packet_size);
     if (fifo->cur_packet != -1) {
         num_bytes += fifo->packet_size - fifo->cur_offset;
     }
-    _saudio_mutex_unlock();
     SOKOL_ASSERT((num_bytes >= 0) && (num_bytes <= (fifo->num_packets * fifo->packet_size)));
     return num_bytes;
 }
 
+/* get a pointer to the free space in the current write packet, this is
+    called from main thread, returns 0 if the write queue is empty
+*/
+_SOKOL_PRIVATE uint8_t* _saudio_fifo_begin_write(_saudio_fifo* fifo, int* num_bytes) {
+    /* need to grab a new packet? */
+    if (fifo->cur_packet == -1) {
+        _saudio_ring_dequeue(&fifo->write_queue, &fifo->cur_packet);
+        SOKOL_ASSERT(fifo->cur_offset == 0);
+    }
+    if (fifo->cur_packet != -1) {
+        *num_bytes = fifo->packet_size - fifo->cur_offset;
+        return fifo->base_ptr + fifo->cur_packet * fifo->packet_size + fifo->cur_offset;
+    }
+    else {
+        *num_bytes = 0;
+        return 0;
+    }
+}
+
+/* commit data written to the pointer returned by _saudio_fifo_begin_write() */
+_SOKOL_PRIVATE void _saudio_fifo_end_write(_saudio_fifo* fifo, int num_bytes) {
+    SOKOL_ASSERT((num_bytes == 0) || (fifo->cur_packet != -1));
+    fifo->cur_offset += num_bytes;
+    SOKOL_ASSERT((fifo->cur_offset >= 0) && (fifo->cur_offset <= fifo->packet_size));
+    /* if write packet is full, push to read queue (which can't be full,
+        there are only num_packets packets in both queues)
+    */
+    if (fifo->cur_offset == fifo->packet_size) {
+        const bool enqueued = _saudio_ring_enqueue(&fifo->read_queue, fifo->cur_packet);
+        SOKOL_ASSERT(enqueued); (void)enqueued;
+        fifo->cur_packet = -1;
+        fifo->cur_offset = 0;
+    }
+}
+
 /* write new data to the write queue, this is called from main thread */
 _SOKOL_PRIVATE int _saudio_fifo_write(_saudio_fifo* fifo, const uint8_t* ptr, int num_bytes) {
     /* returns the number of bytes written, this will be smaller then requested
@@ -601,44 +657,21 @@ _SOKOL_PRIVATE int _saudio_fifo_write(_saudio_fifo* fifo, const uint8_t* ptr, in
     */
     int all_to_copy = num_bytes;
     while (all_to_copy > 0) {
-        /* need to grab a new packet? */
-        if (fifo->cur_packet == -1) {
-            _saudio_mutex_lock();
-            if (!_saudio_ring_empty(&fifo->write_queue)) {
-                fifo->cur_packet = _saudio_ring_dequeue(&fifo->write_queue);
-            }
-            _saudio_mutex_unlock();
-            SOKOL_ASSERT(fifo->cur_offset == 0);
-        }
-        /* append data to current write packet */
-        if (fifo->cur_packet != -1) {
-            int to_copy = all_to_copy;
-            const int max_copy = fifo->packet_size - fifo->cur_offset;
-            if (to_copy > max_copy) {
-                to_copy = max_copy;
-            }
-            uint8_t* dst = fifo->base_ptr + fifo->cur_packet * fifo->packet_size + fifo->cur_offset;
-            memcpy(dst, ptr, to_copy);
-            ptr += to_copy;
-            fifo->cur_offset += to_copy;
-            all_to_copy -= to_copy;
-            SOKOL_ASSERT(fifo->cur_offset <= fifo->packet_size);
-            SOKOL_ASSERT(all_to_copy >= 0);
-        }
-        else {
+        int max_copy;
+        uint8_t* dst = _saudio_fifo_begin_write(fifo, &max_copy);
+        if (!dst) {
             /* early out if we're starving */
             int bytes_copied = num_bytes - all_to_copy;
             SOKOL_ASSERT((bytes_copied >= 0) && (bytes_copied < num_bytes));
             return bytes_copied;
         }
-        /* if write packet is full, push to read queue */
-        if (fifo->cur_offset == fifo->packet_size) {
-            _saudio_mutex_lock();
-            _saudio_ring_enqueue(&fifo->read_queue, fifo->cur_packet);
-            _saudio_mutex_unlock();
-            fifo->cur_packet = -1;
-            fifo->cur_offset = 0;
-        }
+        /* append data to current write packet */
+        const int to_copy = (all_to_copy < max_copy) ? all_to_copy : max_copy;
+        memcpy(dst, ptr, to_copy);
+        ptr += to_copy;
+        all_to_copy -= to_copy;
+        SOKOL_ASSERT(all_to_copy >= 0);
+        _saudio_fifo_end_write(fifo, to_copy);
     }
     SOKOL_ASSERT(all_to_copy == 0);
     return num_bytes;
@@ -647,27 +680,32 @@ _SOKOL_PRIVATE int _saudio_fifo_write(_saudio_fifo* fifo, const uint8_t* ptr, in
 /* read queued data, this is called form the stream callback (maybe separate thread) */
 _SOKOL_PRIVATE int _saudio_fifo_read(_saudio_fifo* fifo, uint8_t* ptr, int num_bytes) {
     /* NOTE: fifo_read might be called before the fifo is properly initialized */
-    _saudio_mutex_lock();
     int num_bytes_copied = 0;
-    if (fifo->valid) {
+    if (_saudio_load_acquire(&fifo->valid)) {
         SOKOL_ASSERT(0 == (num_bytes % fifo->packet_size));
         SOKOL_ASSERT(num_bytes <= (fifo->packet_size * fifo->num_packets));
         const int num_packets_needed = num_bytes / fifo->packet_size;
         uint8_t* dst = ptr;
-        /* either pull a full buffer worth of data, or nothing */
+        /* either pull a full buffer worth of data, or nothing (this is the
+            only thread dequeueing from the read queue, so the packets
+            counted here can't go away)
+        */
         if (_saudio_ring_count(&fifo->read_queue) >= num_packets_needed) {
             for (int i = 0; i < num_packets_needed; i++) {
-                int packet_index = _saudio_ring_dequeue(&fifo->read_queue);
-                _saudio_ring_enqueue(&fifo->write_queue, packet_index);
+                int packet_index = -1;
+                _saudio_ring_dequeue(&fifo->read_queue, &packet_index);
+                SOKOL_ASSERT(packet_index != -1);
                 const uint8_t* src = fifo->base_ptr + packet_index * fifo->packet_size;
                 memcpy(dst, src, fifo->packet_size);
+                /* only hand the packet back after it has been copied */
+                const bool enqueued = _saudio_ring_enqueue(&fifo->write_queue, packet_index);
+                SOKOL_ASSERT(enqueued); (void)enqueued;
                 dst += fifo->packet_size;
                 num_bytes_copied += fifo->packet_size;
             }
             SOKOL_ASSERT(num_bytes == num_bytes_copied);
         }
     }
-    _saudio_mutex_unlock();
     return num_bytes_copied;
 }
 
@@ -1248,7 +1286,6 @@ SOKOL_API_IMPL void saudio_setup(const saudio_desc* desc) {
     _saudio.packet_frames = _saudio_def(_saudio.desc.packet_frames, _SAUDIO_DEFAULT_PACKET_FRAMES);
     _saudio.num_packets = _saudio_def(_saudio.desc.num_packets, _SAUDIO_DEFAULT_NUM_PACKETS);
     _saudio.num_channels = _saudio_def(_saudio.desc.num_channels, 1);
-    _saudio_mutex_init();
     if (_saudio_backend_init()) {
         SOKOL_ASSERT(0 == (_saudio.buffer_frames % _saudio.packet_frames));
         SOKOL_ASSERT(_saudio.bytes_per_frame > 0);
@@ -1263,7 +1300,6 @@ SOKOL_API_IMPL void saudio_shutdown(void) {
         _saudio_fifo_shutdown(&_saudio.fifo);
         _saudio.valid = false;
     }
-    _saudio_mutex_destroy();
 }
 
 SOKOL_API_IMPL bool saudio_isvalid(void) {
@@ -1304,6 +1340,27 @@ SOKOL_API_IMPL int saudio_push(const float* frames, int num_frames) {
     }
 }
 
+SOKOL_API_IMPL float* saudio_begin_write(int* num_frames) {
+    SOKOL_ASSERT(num_frames);
+    if (_saudio.valid) {
+        int num_bytes;
+        float* ptr = (float*) _saudio_fifo_begin_write(&_saudio.fifo, &num_bytes);
+        *num_frames = num_bytes / _saudio.bytes_per_frame;
+        return ptr;
+    }
+    else {
+        *num_frames = 0;
+        return 0;
+    }
+}
+
+SOKOL_API_IMPL void saudio_end_write(int num_frames) {
+    SOKOL_ASSERT(num_frames >= 0);
+    if (_saudio.valid) {
+        _saudio_fifo_end_write(&_saudio.fifo, num_frames * _saudio.bytes_per_frame);
+    }
+}
+
 #undef _saudio_def
 #undef _saudio_def_flt
 
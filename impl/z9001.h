@@ -428,17 +428,7 @@ static uint64_t _z9001_tick(int num_ticks, uint64_t pins, void* user_data) {
         pins = z80ctc_tick(&sys->ctc, pins);
         if (pins & Z80CTC_ZCTO0) {
             /* CTC channel 0 controls the beeper frequency */
-            beeper_toggle(&sys->beeper);
-        }
-        if (beeper_tick(&sys->beeper)) {
-            /* new audio sample ready */
-            sys->sample_buffer[sys->sample_pos++] = sys->beeper.sample;
-            if (sys->sample_pos == sys->num_samples) {
-                if (sys->audio_cb) {
-                    sys->audio_cb(sys->sample_buffer, sys->num_samples, sys->user_data);
-                }
-                sys->sample_pos = 0;
-            }
+            beeper_toggle_at(&sys->beeper, i);
         }
         /* the blink flip flop is controlled by a 'bisync' video signal
             (I guess that means it triggers at half PAL frequency: 25Hz),
@@ -452,6 +442,16 @@ static uint64_t _z9001_tick(int num_ticks, uint64_t pins, void* user_data) {
     }
     sys->ctc_zcto2 = (pins & Z80CTC_ZCTO2);
     pins = pins & Z80_PIN_MASK;
+    if (beeper_ticks(&sys->beeper, num_ticks)) {
+        /* new audio sample ready */
+        sys->sample_buffer[sys->sample_pos++] = sys->beeper.sample;
+        if (sys->sample_pos == sys->num_samples) {
+            if (sys->audio_cb) {
+                sys->audio_cb(sys->sample_buffer, sys->num_samples, sys->user_data);
+            }
+            sys->sample_pos = 0;
+        }
+    }
 
     /* memory and IO requests */
     if (pins & Z80_MREQ) {
@@ -18,11 +18,20 @@
     ~~~
         your own assert macro (default: assert(c))
 
+    Define the following macro to make zx_exec() run a copy of
+    z80_exec() with the tick function known at compile time (see the
+    'Compile-time tick callback' section in z80.h):
+
+    ~~~C
+    CHIPS_INLINE_TICK
+    ~~~
+
     You need to include the following headers before including zx.h:
 
     - chips/z80.h
     - chips/beeper.h
     - chips/ay38910.h
+    - chips/resampler.h
     - chips/mem.h
     - chips/kbd.h
     - chips/clk.h
@@ -112,6 +121,8 @@ typedef struct {
     int audio_sample_rate;          /* playback sample rate, default is 44100 */
     float audio_beeper_volume;      /* volume of the ZX48K beeper: 0.0..1.0, default is 0.25 */
     float audio_ay_volume;          /* volume of the ZX128 AY sound chip: 0.0..1.0, default is 0.5 */
+    float* audio_kernel_buffer;     /* optional (ZX128 only): memory for the AY resampler kernel to share between instances with the same sample rate */
+    int audio_kernel_buffer_size;   /* size of the kernel buffer in bytes, RESAMPLER_MAX_KERNEL_SIZE bytes are always enough */
 
     /* ROMs for ZX Spectrum 48K */
     const void* rom_zx48k;
@@ -129,6 +140,7 @@ typedef struct {
     z80_t cpu;
     beeper_t beeper;
     ay38910_t ay;
+    resampler_t ay_resampler;       /* AY-3-8912 native rate to audio sample rate */
     bool valid;
     zx_type_t type;
     zx_joystick_type_t joystick_type;
@@ -154,6 +166,9 @@ typedef struct {
     int num_samples;
     int sample_pos;
     float sample_buffer[ZX_MAX_AUDIO_SAMPLES];
+    uint32_t ay_ticks;              /* AY-3-8912 ticks which haven't been rendered yet */
+    int ay_pos;
+    float ay_buffer[ZX_MAX_AUDIO_SAMPLES + 16];
     uint8_t ram[8][0x4000];
     uint8_t rom[2][0x4000];
     uint8_t junk[0x4000];
@@ -206,8 +221,19 @@ static void _zx_init_memory_map(zx_t* sys);
 static void _zx_init_keyboard_matrix(zx_t* sys);
 static bool _zx_decode_scanline(zx_t* sys);
 
+#ifdef CHIPS_INLINE_TICK
+/* a z80_exec() copy which calls _zx_tick() directly, see _z80_exec.h */
+#define Z80_EXEC_FUNC _zx_z80_exec
+#define Z80_EXEC_TICK _zx_tick
+#include "_z80_exec.h"
+#define _ZX_Z80_EXEC _zx_z80_exec
+#else
+#define _ZX_Z80_EXEC z80_exec
+#endif
+
 #define _ZX_DEFAULT(val,def) (((val) != 0) ? (val) : (def));
 #define _ZX_CLEAR(val) memset(&val, 0, sizeof(val))
+#define _ZX_AY_CHUNK (256)
 
 void zx_init(zx_t* sys, const zx_desc_t* desc) {
     CHIPS_ASSERT(sys && desc);
@@ -262,9 +288,24 @@ void zx_init(zx_t* sys, const zx_desc_t* desc) {
         _ZX_CLEAR(ay_desc);
         ay_desc.type = AY38910_TYPE_8912;
         ay_desc.tick_hz = cpu_freq / 2;
-        ay_desc.sound_hz = audio_hz;
+        ay_desc.sound_hz = ay_desc.tick_hz / 8;
         ay_desc.magnitude = _ZX_DEFAULT(desc->audio_ay_volume, 0.5f);
         ay38910_init(&sys->ay, &ay_desc);
+        /* the AY output only changes every 8 AY ticks (16 CPU ticks),
+           sampling it at that rate is exact, the resampler takes it from
+           there to the audio rate; the rates are given as the output and
+           input sample periods in 1/BEEPER_FIXEDPOINT_SCALE CPU ticks
+           (the output period is the beeper's), this way the AY and the
+           beeper produce the same number of samples
+        */
+        resampler_desc_t rs_desc;
+        _ZX_CLEAR(rs_desc);
+        rs_desc.in_hz = sys->beeper.period;
+        rs_desc.out_hz = 16 * BEEPER_FIXEDPOINT_SCALE;
+        rs_desc.kernel_buffer = desc->audio_kernel_buffer;
+        rs_desc.kernel_buffer_size = desc->audio_kernel_buffer_size;
+        CHIPS_ASSERT(rs_desc.out_hz <= rs_desc.in_hz);
+        resampler_init(&sys->ay_resampler, &rs_desc);
     }
     _zx_init_memory_map(sys);
     _zx_init_keyboard_matrix(sys);
@@ -283,6 +324,9 @@ void zx_reset(zx_t* sys) {
     beeper_reset(&sys->beeper);
     if (sys->type == ZX_TYPE_128) {
         ay38910_reset(&sys->ay);
+        resampler_reset(&sys->ay_resampler);
+        sys->ay_ticks = 0;
+        sys->ay_pos = 0;
     }
     sys->memory_paging_disabled = false;
     sys->kbd_joymask = 0;
@@ -304,7 +348,7 @@ void zx_reset(zx_t* sys) {
 void zx_exec(zx_t* sys, uint32_t micro_seconds) {
     CHIPS_ASSERT(sys && sys->valid);
     uint32_t ticks_to_run = clk_ticks_to_run(&sys->clk, micro_seconds);
-    uint32_t ticks_executed = z80_exec(&sys->cpu, ticks_to_run);
+    uint32_t ticks_executed = _ZX_Z80_EXEC(&sys->cpu, ticks_to_run);
     clk_ticks_executed(&sys->clk, ticks_executed);
     kbd_update(&sys->kbd);
 }
@@ -445,6 +489,42 @@ static uint32_t _zx_palette[8] = {
     0xFFFFFFFF,     // white
 };
 
+/* render the AY-3-8912 samples up to the current tick */
+static void _zx_ay_catchup(zx_t* sys) {
+    float ay_samples[_ZX_AY_CHUNK];
+    float samples[_ZX_AY_CHUNK + 1];
+    int num_ay_samples;
+    do {
+        num_ay_samples = ay38910_render(&sys->ay, sys->ay_ticks, ay_samples, _ZX_AY_CHUNK);
+        sys->ay_ticks = 0;
+        const int num_samples = resampler_process(&sys->ay_resampler, ay_samples, num_ay_samples, samples);
+        for (int i = 0; i < num_samples; i++) {
+            if (sys->ay_pos < (int)(sizeof(sys->ay_buffer) / sizeof(float))) {
+                sys->ay_buffer[sys->ay_pos++] = samples[i];
+            }
+        }
+    }
+    while (num_ay_samples == _ZX_AY_CHUNK);
+}
+
+/* mix the AY-3-8912 samples into the full sample buffer */
+static void _zx_ay_mix(zx_t* sys) {
+    _zx_ay_catchup(sys);
+    /* the AY and beeper samples are produced at the same rate, but not on
+       the same ticks, so the AY may be one sample short or ahead at the end
+       of the buffer: a missing sample repeats the last, an extra sample is
+       kept for the next buffer
+    */
+    for (int i = 0; i < sys->num_samples; i++) {
+        sys->sample_buffer[i] += (i < sys->ay_pos) ? sys->ay_buffer[i] : sys->ay_resampler.sample;
+    }
+    int num_left = 0;
+    for (int i = sys->num_samples; i < sys->ay_pos; i++) {
+        sys->ay_buffer[num_left++] = sys->ay_buffer[i];
+    }
+    sys->ay_pos = num_left;
+}
+
 static uint64_t _zx_tick(int num_ticks, uint64_t pins, void* user_data) {
     zx_t* sys = (zx_t*) user_data;
     /* video decoding and vblank interrupt */
@@ -458,28 +538,24 @@ static uint64_t _zx_tick(int num_ticks, uint64_t pins, void* user_data) {
         }
     }
 
-    /* tick audio systems */
-    for (int i = 0; i < num_ticks; i++) {
-        sys->tick_count++;
-        bool sample_ready = beeper_tick(&sys->beeper);
-        /* the AY-3-8912 chip runs at half CPU frequency */
-        if (sys->type == ZX_TYPE_128) {
-            if (sys->tick_count & 1) {
-                ay38910_tick(&sys->ay);
-            }
-        }
-        if (sample_ready) {
-            float sample = sys->beeper.sample;
+    /* tick audio systems, the AY-3-8912 chip runs at half CPU frequency
+       (on odd tick counts), and is only rendered when a register is
+       written or the sample buffer is full
+    */
+    if (sys->type == ZX_TYPE_128) {
+        sys->ay_ticks += (num_ticks + ((sys->tick_count & 1) ^ 1)) >> 1;
+        sys->tick_count += num_ticks;
+    }
+    if (beeper_ticks(&sys->beeper, num_ticks)) {
+        sys->sample_buffer[sys->sample_pos++] = sys->beeper.sample;
+        if (sys->sample_pos == sys->num_samples) {
             if (sys->type == ZX_TYPE_128) {
-                sample += sys->ay.sample;
+                _zx_ay_mix(sys);
             }
-            sys->sample_buffer[sys->sample_pos++] = sample;
-            if (sys->sample_pos == sys->num_samples) {
-                if (sys->audio_cb) {
-                    sys->audio_cb(sys->sample_buffer, sys->num_samples, sys->user_data);
-                }
-                sys->sample_pos = 0;
+            if (sys->audio_cb) {
+                sys->audio_cb(sys->sample_buffer, sys->num_samples, sys->user_data);
             }
+            sys->sample_pos = 0;
         }
     }
 
@@ -579,6 +655,7 @@ static uint64_t _zx_tick(int num_ticks, uint64_t pins, void* user_data) {
                 }
                 else if ((pins & (Z80_A15|Z80_A14|Z80_A1)) == Z80_A15) {
                     /* write to AY-3-8912 (10............0.) */
+                    _zx_ay_catchup(sys);
                     ay38910_iorq(&sys->ay, AY38910_BDIR|pins);
                 }
             }
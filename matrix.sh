@@ -0,0 +1,79 @@
+# compiler and language-mode matrix
+#
+# Compiles every benchmark TU with gcc and clang (if installed), in C mode
+# and C++ mode, at several -std levels, and prints one comparison table
+# (median ms per compile, rows are TUs, columns are compiler/std). The C
+# TUs are compiled as C++ with '-x c++', C++-only TUs (stdvector.cc) are
+# skipped in C mode. Results go to matrix.csv.
+#
+# Environment:
+#   COMPILERS="gcc clang"           C compilers (C++ compiler is derived)
+#   C_STDS="gnu99 gnu11 gnu17"      C standards
+#   CXX_STDS="c++11 c++17 c++20"    C++ standards
+#   RUNS=20                         timed runs per cell
+#
+# (the gnu C modes are needed because m6581.h uses M_PI)
+COMPILERS=${COMPILERS:-"gcc clang"}
+C_STDS=${C_STDS:-"gnu99 gnu11 gnu17"}
+CXX_STDS=${CXX_STDS:-"c++11 c++17 c++20"}
+RUNS=${RUNS:-20}
+OUT=_matrix
+
+# TU name and source file
+TUS="empty:empty.c crt_c99:crt_c99.c decl-orig:decl-orig.c decl-only:decl-only.c
+    decl-nocomments:decl-nocomments.c stdvector:stdvector.cc impl:impl-chips.c"
+
+cxx_for() {
+    case $1 in
+        gcc) echo g++ ;;
+        clang) echo clang++ ;;
+        *) echo $1++ ;;
+    esac
+}
+
+cc -O2 -o bench bench.c -lm || exit 1
+rm -rf $OUT && mkdir -p $OUT
+
+set --
+COLUMNS=""
+for comp in $COMPILERS; do
+    command -v $comp > /dev/null || { echo "skipping $comp (not installed)"; continue; }
+    cxx=$(cxx_for $comp)
+    for std in $C_STDS; do
+        COLUMNS="$COLUMNS $comp/$std"
+        for tu in $TUS; do
+            name=${tu%%:*}; src=${tu#*:}
+            case $src in *.cc) continue ;; esac
+            set -- "$@" "$name@$comp/$std" "$comp -std=$std -I. -c $src -o $OUT/$name.o"
+        done
+    done
+    for std in $CXX_STDS; do
+        COLUMNS="$COLUMNS $comp/$std"
+        for tu in $TUS; do
+            name=${tu%%:*}; src=${tu#*:}
+            set -- "$@" "$name@$comp/$std" "$cxx -std=$std -x c++ -I. -c $src -o $OUT/$name.o"
+        done
+    done
+done
+./bench -w 2 -n $RUNS -c matrix.csv "$@" > /dev/null || exit 1
+
+# pivot the median times into one table
+awk -F, -v columns="$COLUMNS" -v tus="$TUS" 'NR > 1 { t[$1] = $4 }
+    END {
+        nc = split(columns, col, " ")
+        nt = split(tus, tu, /[ \n]+/)
+        printf "%-16s", "median ms"
+        for (c = 1; c <= nc; c++) printf " %13s", col[c]
+        printf "\n"
+        for (i = 1; i <= nt; i++) {
+            if (tu[i] == "") continue
+            name = tu[i]; sub(/:.*/, "", name)
+            printf "%-16s", name
+            for (c = 1; c <= nc; c++) {
+                key = name "@" col[c]
+                if (key in t) printf " %13.2f", t[key]
+                else printf " %13s", "-"
+            }
+            printf "\n"
+        }
+    }' matrix.csv
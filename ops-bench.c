@@ -0,0 +1,807 @@
+/*
+    ops-bench.c -- per-opcode microbenchmark for z80_exec and m6502_exec
+
+    Runs every opcode of the Z80 (unprefixed, CB, ED, DD, FD, DD CB and
+    FD CB, documented and undocumented) and the 6502 (all 256 opcodes)
+    from impl/ in a tight loop, with a trivial tick callback which only
+    reads and writes a 64 KByte memory array, and reports host nanoseconds
+    per emulated instruction and per emulated T-state (clock cycle).
+
+    Each opcode is written many times in a row into the code area (which
+    is read-only for the CPU), followed by a trap, and the CPU registers
+    are reset before each pass. Control flow instructions are set up so
+    they always continue at the next copy: jump and call targets point to
+    the next copy, relative branches have offset 0, and the stack is
+    prefilled with the next copy addresses for returns. Instructions which
+    can't be chained (RST, JP (HL), HALT, BRK) loop on themselves, and the
+    block repeat instructions (LDIR, CPIR, INIR, ...) run one copy with
+    many iterations; for these the instructions are counted in the tick
+    callback (opcode fetches at the instruction address).
+
+    Build:
+        cc -O2 -o ops-bench ops-bench.c
+
+    Usage:
+        ./ops-bench [options] [z80] [m6502]
+
+    Options:
+        -t MS       minimum duration of one timed trial (default: 2)
+        -r N        number of trials per opcode, the fastest counts (default: 5)
+        -c FILE     write CSV results to FILE (one line per opcode)
+        -k N        number of slowest opcodes to list (default: 20)
+        -q          don't print the result table to stdout
+*/
+#define _GNU_SOURCE
+#define CHIPS_IMPL
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "impl/z80.h"
+#include "impl/m6502.h"
+
+#define OPS_MAX_RESULTS (2048)
+#define OPS_NUM_COPIES (4096)
+#define OPS_SELF_LOOP_TICKS (65536)
+
+/* Z80 memory layout: code in the read-only lower half, data and stack in the upper half */
+#define Z80_CODE_ADDR (0x0100)
+#define Z80_RO_END (0x8000)
+#define Z80_DATA_ADDR (0x9000)
+#define Z80_STACK_ADDR (0xC000)
+
+/* 6502 memory layout: zero page and stack are RAM, code is read-only */
+#define M6502_CODE_ADDR (0x1000)
+#define M6502_RO_START (0x0200)
+#define M6502_RO_END (0x8000)
+#define M6502_DATA_ADDR (0x9000)
+#define M6502_ZP_ADDR (0x40)
+
+typedef enum {
+    FLOW_NORMAL,        /* falls through to the next copy */
+    FLOW_JUMP,          /* absolute jump/call, target is the next copy */
+    FLOW_RET,           /* return, stack prefilled with the next copies */
+    FLOW_SELF,          /* loops on itself, counted in the tick callback */
+    FLOW_REPEAT,        /* block repeat, single copy, counted in the tick callback */
+} flow_t;
+
+typedef struct {
+    const char* cpu;
+    const char* prefix;
+    int opcode;
+    char name[24];
+    int num_bytes;
+    double tstates;
+    double ns_per_instr;
+    double ns_per_tstate;
+} result_t;
+
+static struct {
+    double trial_ms;
+    int num_trials;
+    int top;
+    const char* csv_path;
+    bool quiet;
+    uint8_t mem[1<<16];
+    /* address of opcode fetches to count (FLOW_SELF and FLOW_REPEAT) */
+    uint16_t watch_addr;
+    uint64_t watch_count;
+    int num_results;
+    result_t results[OPS_MAX_RESULTS];
+} ops = {
+    .trial_ms = 2.0,
+    .num_trials = 5,
+    .top = 20,
+};
+
+static void usage(void) {
+    fprintf(stderr, "usage: ops-bench [-t ms] [-r trials] [-c csv] [-k top] [-q] [z80] [m6502]\n");
+    exit(2);
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/*=== Z80 ====================================================================*/
+static uint64_t z80_tick(int num_ticks, uint64_t pins, void* user_data) {
+    (void)num_ticks; (void)user_data;
+    if (pins & Z80_MREQ) {
+        const uint16_t addr = Z80_GET_ADDR(pins);
+        if (pins & Z80_RD) {
+            Z80_SET_DATA(pins, ops.mem[addr]);
+        }
+        else if ((pins & Z80_WR) && (addr >= Z80_RO_END)) {
+            ops.mem[addr] = Z80_GET_DATA(pins);
+        }
+    }
+    else if ((pins & Z80_IORQ) && (pins & Z80_RD)) {
+        Z80_SET_DATA(pins, 0xFF);
+    }
+    return pins;
+}
+
+static uint64_t z80_tick_count(int num_ticks, uint64_t pins, void* user_data) {
+    if ((pins & Z80_M1) && (Z80_GET_ADDR(pins) == ops.watch_addr)) {
+        ops.watch_count++;
+    }
+    return z80_tick(num_ticks, pins, user_data);
+}
+
+/* instruction length without prefixes, 0 for prefix bytes */
+static int z80_main_len(int op) {
+    const int x = op>>6, y = (op>>3)&7, z = op&7, p = y>>1, q = y&1;
+    switch (x) {
+        case 0:
+            switch (z) {
+                case 0: return (y < 2) ? 1 : 2;
+                case 1: return (q == 0) ? 3 : 1;
+                case 2: return (p >= 2) ? 3 : 1;
+                case 6: return 2;
+                default: return 1;
+            }
+        case 3:
+            switch (z) {
+                case 2: case 4: return 3;
+                case 3: return (y == 0) ? 3 : ((y == 1) ? 0 : ((y < 4) ? 2 : 1));
+                case 5: return (q == 0) ? 1 : ((p == 0) ? 3 : 0);
+                case 6: return 2;
+                default: return 1;
+            }
+        default:
+            return 1;
+    }
+}
+
+/* true if the instruction has an (HL) operand which becomes (IX+d) */
+static bool z80_has_disp(int op) {
+    const int x = op>>6, y = (op>>3)&7, z = op&7;
+    if ((op >= 0x34) && (op <= 0x36)) {
+        return true;
+    }
+    if ((x == 1) && (op != 0x76) && ((y == 6) || (z == 6))) {
+        return true;
+    }
+    return (x == 2) && (z == 6);
+}
+
+static flow_t z80_main_flow(int op) {
+    const int x = op>>6, y = (op>>3)&7, z = op&7;
+    if (op == 0x76) {
+        return FLOW_SELF;       /* HALT */
+    }
+    if (x == 0 && z == 0 && y >= 2) {
+        return FLOW_NORMAL;     /* DJNZ/JR, offset 0 */
+    }
+    if (x == 3) {
+        if ((z == 2) || (z == 4) || (op == 0xC3) || (op == 0xCD)) {
+            return FLOW_JUMP;
+        }
+        if ((z == 0) || (op == 0xC9)) {
+            return FLOW_RET;
+        }
+        if ((z == 7) || (op == 0xE9)) {
+            return FLOW_SELF;   /* RST, JP (HL) */
+        }
+    }
+    return FLOW_NORMAL;
+}
+
+static void z80_name(char* buf, size_t size, const char* prefix, int op) {
+    static const char* cc[8] = { "NZ", "Z", "NC", "C", "PO", "PE", "P", "M" };
+    static const char* alu[8] = { "ADD A,", "ADC A,", "SUB ", "SBC A,", "AND ", "XOR ", "OR ", "CP " };
+    static const char* rot[8] = { "RLC", "RRC", "RL", "RR", "SLA", "SRA", "SLL", "SRL" };
+    static const char* bli[4][4] = {
+        { "LDI", "CPI", "INI", "OUTI" }, { "LDD", "CPD", "IND", "OUTD" },
+        { "LDIR", "CPIR", "INIR", "OTIR" }, { "LDDR", "CPDR", "INDR", "OTDR" },
+    };
+    static const char* im[8] = { "0", "0/1", "1", "2", "0", "0/1", "1", "2" };
+    const int x = op>>6, y = (op>>3)&7, z = op&7, p = y>>1, q = y&1;
+    const bool ix = (prefix[0] == 'D'), iy = (prefix[0] == 'F');
+    const char* hl = ix ? "IX" : (iy ? "IY" : "HL");
+    const char* mhl = ix ? "(IX+d)" : (iy ? "(IY+d)" : "(HL)");
+    const char* r[8] = { "B", "C", "D", "E", ix ? "IXH" : (iy ? "IYH" : "H"), ix ? "IXL" : (iy ? "IYL" : "L"), mhl, "A" };
+    const char* r_plain[8] = { "B", "C", "D", "E", "H", "L", mhl, "A" };
+    const char* rp[4] = { "BC", "DE", hl, "SP" };
+    const char* rp2[4] = { "BC", "DE", hl, "AF" };
+
+    if (strstr(prefix, "CB")) {
+        const char* m = strcmp(prefix, "CB") ? mhl : r[z];
+        const char* reg = (strcmp(prefix, "CB") && (z != 6)) ? r_plain[z] : 0;
+        char target[16];
+        snprintf(target, sizeof(target), "%s%s%s", m, reg ? "," : "", reg ? reg : "");
+        switch (x) {
+            case 0: snprintf(buf, size, "%s %s", rot[y], target); break;
+            case 1: snprintf(buf, size, "BIT %d,%s", y, m); break;
+            case 2: snprintf(buf, size, "RES %d,%s", y, target); break;
+            default: snprintf(buf, size, "SET %d,%s", y, target); break;
+        }
+        return;
+    }
+    if (0 == strcmp(prefix, "ED")) {
+        if (x == 1) {
+            switch (z) {
+                case 0: snprintf(buf, size, (y == 6) ? "IN (C)" : "IN %s,(C)", r_plain[y]); break;
+                case 1: snprintf(buf, size, (y == 6) ? "OUT (C),0" : "OUT (C),%s", r_plain[y]); break;
+                case 2: snprintf(buf, size, "%s HL,%s", q ? "ADC" : "SBC", rp[p]); break;
+                case 3: snprintf(buf, size, q ? "LD %s,(nn)" : "LD (nn),%s", rp[p]); break;
+                case 4: snprintf(buf, size, "NEG"); break;
+                case 5: snprintf(buf, size, (y == 1) ? "RETI" : "RETN"); break;
+                case 6: snprintf(buf, size, "IM %s", im[y]); break;
+                default: {
+                    static const char* misc[8] = { "LD I,A", "LD R,A", "LD A,I", "LD A,R", "RRD", "RLD", "NOP", "NOP" };
+                    snprintf(buf, size, "%s", misc[y]);
+                } break;
+            }
+        }
+        else if ((x == 2) && (z <= 3) && (y >= 4)) {
+            snprintf(buf, size, "%s", bli[y-4][z]);
+        }
+        else {
+            snprintf(buf, size, "NOP (ED %02X)", op);
+        }
+        return;
+    }
+    switch (x) {
+        case 0:
+            switch (z) {
+                case 0: {
+                    static const char* n[4] = { "NOP", "EX AF,AF'", "DJNZ d", "JR d" };
+                    if (y < 4) snprintf(buf, size, "%s", n[y]);
+                    else snprintf(buf, size, "JR %s,d", cc[y-4]);
+                } break;
+                case 1: snprintf(buf, size, q ? "ADD %s,%s" : "LD %s%snn", q ? hl : rp[p], q ? rp[p] : ","); break;
+                case 2: {
+                    static const char* ld[8] = { "LD (BC),A", "LD A,(BC)", "LD (DE),A", "LD A,(DE)", "LD (nn),%s", "LD %s,(nn)", "LD (nn),A", "LD A,(nn)" };
+                    snprintf(buf, size, ld[y], hl);
+                } break;
+                case 3: snprintf(buf, size, "%s %s", q ? "DEC" : "INC", rp[p]); break;
+                case 4: snprintf(buf, size, "INC %s", r[y]); break;
+                case 5: snprintf(buf, size, "DEC %s", r[y]); break;
+                case 6: snprintf(buf, size, "LD %s,n", r[y]); break;
+                default: {
+                    static const char* n[8] = { "RLCA", "RRCA", "RLA", "RRA", "DAA", "CPL", "SCF", "CCF" };
+                    snprintf(buf, size, "%s", n[y]);
+                } break;
+            }
+            break;
+        case 1:
+            if (op == 0x76) {
+                snprintf(buf, size, "HALT");
+            }
+            else if ((y == 6) || (z == 6)) {
+                snprintf(buf, size, "LD %s,%s", r_plain[y], r_plain[z]);
+            }
+            else {
+                snprintf(buf, size, "LD %s,%s", r[y], r[z]);
+            }
+            break;
+        case 2:
+            snprintf(buf, size, "%s%s", alu[y], r[z]);
+            break;
+        default:
+            switch (z) {
+                case 0: snprintf(buf, size, "RET %s", cc[y]); break;
+                case 1:
+                    if (q == 0) {
+                        snprintf(buf, size, "POP %s", rp2[p]);
+                    }
+                    else {
+                        static const char* n[4] = { "RET", "EXX", "JP (%s)", "LD SP,%s" };
+                        snprintf(buf, size, n[p], hl);
+                    }
+                    break;
+                case 2: snprintf(buf, size, "JP %s,nn", cc[y]); break;
+                case 3: {
+                    static const char* n[8] = { "JP nn", "CB prefix", "OUT (n),A", "IN A,(n)", "EX (SP),%s", "EX DE,HL", "DI", "EI" };
+                    snprintf(buf, size, n[y], hl);
+                } break;
+                case 4: snprintf(buf, size, "CALL %s,nn", cc[y]); break;
+                case 5: snprintf(buf, size, q ? "CALL nn" : "PUSH %s", rp2[p]); break;
+                case 6: snprintf(buf, size, "%sn", alu[y]); break;
+                default: snprintf(buf, size, "RST %02XH", y*8); break;
+            }
+            break;
+    }
+}
+
+static z80_t z80;
+
+static void z80_reset_regs(uint16_t pc, flow_t flow, int op) {
+    z80_reset(&z80);
+    z80_set_a(&z80, 0x55); z80_set_f(&z80, 0x00);
+    z80_set_bc(&z80, Z80_DATA_ADDR);
+    z80_set_de(&z80, Z80_DATA_ADDR + 0x100);
+    z80_set_hl(&z80, Z80_DATA_ADDR + 0x200);
+    z80_set_ix(&z80, Z80_DATA_ADDR + 0x300);
+    z80_set_iy(&z80, Z80_DATA_ADDR + 0x300);
+    z80_set_af_(&z80, 0x5500);
+    z80_set_bc_(&z80, Z80_DATA_ADDR);
+    z80_set_de_(&z80, Z80_DATA_ADDR + 0x100);
+    z80_set_hl_(&z80, Z80_DATA_ADDR + 0x200);
+    z80_set_sp(&z80, Z80_STACK_ADDR);
+    z80_set_pc(&z80, pc);
+    if (flow == FLOW_SELF) {
+        /* JP (HL/IX/IY) jumps to itself */
+        z80_set_hl(&z80, pc);
+        z80_set_ix(&z80, pc);
+        z80_set_iy(&z80, pc);
+    }
+    else if (flow == FLOW_REPEAT) {
+        /* 1024 iterations for LDxR/CPxR, 256 for the I/O repeats (B=0) */
+        z80_set_bc(&z80, ((op & 3) < 2) ? 0x0400 : 0x00FE);
+    }
+}
+
+/* set up code and data memory for one opcode, returns instructions per pass */
+static int z80_setup(const char* prefix, int op, flow_t* out_flow, int* out_len, uint16_t* out_start, uint16_t* out_end) {
+    uint8_t pre[2] = { 0 };
+    int num_pre = 0;
+    const bool idx = (prefix[0] == 'D') || (prefix[0] == 'F');
+    const bool cb = (0 != strstr(prefix, "CB"));
+    const bool ed = (0 == strcmp(prefix, "ED"));
+    if (idx) pre[num_pre++] = (prefix[0] == 'D') ? 0xDD : 0xFD;
+    if (cb && !idx) pre[num_pre++] = 0xCB;
+    if (ed) pre[num_pre++] = 0xED;
+
+    int len;
+    flow_t flow = FLOW_NORMAL;
+    if (cb) {
+        len = idx ? 4 : 2;
+    }
+    else if (ed) {
+        const int x = op>>6, y = (op>>3)&7, z = op&7;
+        len = ((x == 1) && (z == 3)) ? 4 : 2;
+        if ((x == 1) && (z == 5)) {
+            flow = FLOW_RET;
+        }
+        else if ((x == 2) && (z <= 3) && (y >= 6)) {
+            flow = FLOW_REPEAT;
+        }
+    }
+    else {
+        len = num_pre + z80_main_len(op) + ((idx && z80_has_disp(op)) ? 1 : 0);
+        flow = z80_main_flow(op);
+    }
+
+    memset(ops.mem, 0, sizeof(ops.mem));
+    uint16_t start = Z80_CODE_ADDR;
+    int copies = OPS_NUM_COPIES;
+    if (flow == FLOW_SELF) {
+        const int x = op>>6, z = op&7;
+        if ((x == 3) && (z == 7)) {
+            start = op & 0x38;  /* RST target */
+        }
+        copies = 1;
+    }
+    else if (flow == FLOW_REPEAT) {
+        copies = 1;
+    }
+    for (int i = 0; i < copies; i++) {
+        const uint16_t addr = start + i * len;
+        const uint16_t next = addr + len;
+        uint8_t* m = &ops.mem[addr];
+        int n = 0;
+        for (int k = 0; k < num_pre; k++) {
+            m[n++] = pre[k];
+        }
+        if (cb && idx) {
+            m[n++] = 0xCB;
+            m[n++] = 0x10;  /* d */
+            m[n++] = op;
+            continue;
+        }
+        m[n++] = op;
+        /* fill operands: displacement, then immediate/address */
+        if (idx && !ed && z80_has_disp(op)) {
+            m[n++] = 0x10;
+        }
+        const uint16_t nn = (flow == FLOW_JUMP) ? next : Z80_DATA_ADDR;
+        while (n < len) {
+            const int rem = len - n;
+            if (rem >= 2) {
+                m[n++] = nn & 0xFF;
+                m[n++] = nn >> 8;
+            }
+            else {
+                /* n or d, relative branches get offset 0 */
+                const int x = op>>6, z = op&7;
+                m[n++] = (!ed && (x == 0) && (z == 0)) ? 0x00 : 0x01;
+            }
+        }
+        /* returns pop the address of the next copy */
+        if (flow == FLOW_RET) {
+            const uint16_t sp = Z80_STACK_ADDR + 2 * i;
+            ops.mem[sp] = next & 0xFF;
+            ops.mem[sp + 1] = next >> 8;
+        }
+    }
+    *out_flow = flow;
+    *out_len = len;
+    *out_start = start;
+    *out_end = start + copies * len;
+    ops.watch_addr = start + ((cb && idx) ? 3 : num_pre);
+    return copies;
+}
+
+/* run one pass, returns executed ticks, adds executed instructions to *instr */
+static uint64_t z80_pass(flow_t flow, int op, uint16_t start, int copies, uint64_t* instr) {
+    z80_reset_regs(start, flow, op);
+    uint32_t ticks;
+    if (flow == FLOW_SELF) {
+        ops.watch_count = 0;
+        ticks = z80_exec(&z80, OPS_SELF_LOOP_TICKS);
+        *instr += ops.watch_count;
+    }
+    else if (flow == FLOW_REPEAT) {
+        ops.watch_count = 0;
+        ticks = z80_exec(&z80, 0xFFFFFFFF);
+        *instr += ops.watch_count;
+    }
+    else {
+        ticks = z80_exec(&z80, 0xFFFFFFFF);
+        *instr += copies;
+    }
+    return ticks;
+}
+
+static void z80_bench_op(const char* prefix, int op) {
+    flow_t flow;
+    int len;
+    uint16_t start, end;
+    const int copies = z80_setup(prefix, op, &flow, &len, &start, &end);
+    z80_desc_t desc = { .tick_cb = ((flow == FLOW_SELF) || (flow == FLOW_REPEAT)) ? z80_tick_count : z80_tick };
+    z80_init(&z80, &desc);
+    if (flow != FLOW_SELF) {
+        z80_set_trap(&z80, 0, end);
+    }
+
+    /* calibrate the number of passes per trial */
+    uint64_t instr = 0, ticks = 0;
+    int passes = 0;
+    const double t0 = now_ms();
+    do {
+        ticks += z80_pass(flow, op, start, copies, &instr);
+        passes++;
+    } while ((now_ms() - t0) < ops.trial_ms);
+    const double tpi = (double)ticks / instr;
+
+    double best = 1e30;
+    for (int t = 0; t < ops.num_trials; t++) {
+        instr = 0;
+        const double t1 = now_ms();
+        for (int p = 0; p < passes; p++) {
+            z80_pass(flow, op, start, copies, &instr);
+        }
+        const double ms = now_ms() - t1;
+        const double ns = (ms * 1000000.0) / instr;
+        if (ns < best) {
+            best = ns;
+        }
+    }
+    result_t* res = &ops.results[ops.num_results++];
+    res->cpu = "z80";
+    res->prefix = prefix;
+    res->opcode = op;
+    z80_name(res->name, sizeof(res->name), prefix, op);
+    res->num_bytes = len;
+    res->tstates = tpi;
+    res->ns_per_instr = best;
+    res->ns_per_tstate = best / tpi;
+}
+
+static void z80_bench(void) {
+    static const char* prefixes[] = { "", "CB", "ED", "DD", "FD", "DDCB", "FDCB" };
+    for (int p = 0; p < 7; p++) {
+        for (int op = 0; op < 256; op++) {
+            if ((0 == strcmp(prefixes[p], "")) && ((op == 0xCB) || (op == 0xDD) || (op == 0xED) || (op == 0xFD))) {
+                continue;
+            }
+            if (((0 == strcmp(prefixes[p], "DD")) || (0 == strcmp(prefixes[p], "FD"))) &&
+                ((op == 0xCB) || (op == 0xDD) || (op == 0xED) || (op == 0xFD))) {
+                continue;
+            }
+            z80_bench_op(prefixes[p], op);
+        }
+    }
+}
+
+/*=== 6502 ===================================================================*/
+static const char* m6502_names[256] = {
+    "BRK", "ORA (zp,X)", "INVALID", "SLO (zp,X)*", "NOP zp*", "ORA zp", "ASL zp", "SLO zp*",
+    "PHP", "ORA #", "ASL A", "ANC #*", "NOP abs*", "ORA abs", "ASL abs", "SLO abs*",
+    "BPL rel", "ORA (zp),Y", "INVALID", "SLO (zp),Y*", "NOP zp,X*", "ORA zp,X", "ASL zp,X", "SLO zp,X*",
+    "CLC", "ORA abs,Y", "NOP*", "SLO abs,Y*", "NOP abs,X*", "ORA abs,X", "ASL abs,X", "SLO abs,X*",
+    "JSR abs", "AND (zp,X)", "INVALID", "RLA (zp,X)*", "BIT zp", "AND zp", "ROL zp", "RLA zp*",
+    "PLP", "AND #", "ROL A", "ANC #*", "BIT abs", "AND abs", "ROL abs", "RLA abs*",
+    "BMI rel", "AND (zp),Y", "INVALID", "RLA (zp),Y*", "NOP zp,X*", "AND zp,X", "ROL zp,X", "RLA zp,X*",
+    "SEC", "AND abs,Y", "NOP*", "RLA abs,Y*", "NOP abs,X*", "AND abs,X", "ROL abs,X", "RLA abs,X*",
+    "RTI", "EOR (zp,X)", "INVALID", "SRE (zp,X)*", "NOP zp*", "EOR zp", "LSR zp", "SRE zp*",
+    "PHA", "EOR #", "LSR A", "ASR #*", "JMP abs", "EOR abs", "LSR abs", "SRE abs*",
+    "BVC rel", "EOR (zp),Y", "INVALID", "SRE (zp),Y*", "NOP zp,X*", "EOR zp,X", "LSR zp,X", "SRE zp,X*",
+    "CLI", "EOR abs,Y", "NOP*", "SRE abs,Y*", "NOP abs*", "EOR abs,X", "LSR abs,X", "SRE abs,X*",
+    "RTS", "ADC (zp,X)", "INVALID", "RRA (zp,X)*", "NOP zp*", "ADC zp", "ROR zp", "RRA zp*",
+    "PLA", "ADC #", "ROR A", "ARR #*", "JMP (ind)", "ADC abs", "ROR abs", "RRA abs*",
+    "BVS rel", "ADC (zp),Y", "INVALID", "RRA (zp),Y*", "NOP zp,X*", "ADC zp,X", "ROR zp,X", "RRA zp,X*",
+    "SEI", "ADC abs,Y", "NOP*", "RRA abs,Y*", "NOP abs*", "ADC abs,X", "ROR abs,X", "RRA abs,X*",
+    "NOP #*", "STA (zp,X)", "NOP #*", "SAX (zp,X)*", "STY zp", "STA zp", "STX zp", "SAX zp*",
+    "DEY", "NOP #*", "TXA", "ANE #*", "STY abs", "STA abs", "STX abs", "SAX abs*",
+    "BCC rel", "STA (zp),Y", "INVALID", "SHA (zp),Y*", "STY zp,X", "STA zp,X", "STX zp,Y", "SAX zp,Y*",
+    "TYA", "STA abs,Y", "TXS", "SHS abs,Y*", "SHY abs,X*", "STA abs,X", "SHX abs,Y*", "SHA abs,Y*",
+    "LDY #", "LDA (zp,X)", "LDX #", "LAX (zp,X)*", "LDY zp", "LDA zp", "LDX zp", "LAX zp*",
+    "TAY", "LDA #", "TAX", "LXA #*", "LDY abs", "LDA abs", "LDX abs", "LAX abs*",
+    "BCS rel", "LDA (zp),Y", "INVALID", "LAX (zp),Y*", "LDY zp,X", "LDA zp,X", "LDX zp,Y", "LAX zp,Y*",
+    "CLV", "LDA abs,Y", "TSX", "LAS abs,Y*", "LDY abs,X", "LDA abs,X", "LDX abs,Y", "LAX abs,Y*",
+    "CPY #", "CMP (zp,X)", "NOP #*", "DCP (zp,X)*", "CPY zp", "CMP zp", "DEC zp", "DCP zp*",
+    "INY", "CMP #", "DEX", "SBX #*", "CPY abs", "CMP abs", "DEC abs", "DCP abs*",
+    "BNE rel", "CMP (zp),Y", "INVALID", "DCP (zp),Y*", "NOP zp,X*", "CMP zp,X", "DEC zp,X", "DCP zp,X*",
+    "CLD", "CMP abs,Y", "NOP*", "DCP abs,Y*", "NOP abs,X*", "CMP abs,X", "DEC abs,X", "DCP abs,X*",
+    "CPX #", "SBC (zp,X)", "NOP #*", "ISB (zp,X)*", "CPX zp", "SBC zp", "INC zp", "ISB zp*",
+    "INX", "SBC #", "NOP", "SBC #*", "CPX abs", "SBC abs", "INC abs", "ISB abs*",
+    "BEQ rel", "SBC (zp),Y", "INVALID", "ISB (zp),Y*", "NOP zp,X*", "SBC zp,X", "INC zp,X", "ISB zp,X*",
+    "SED", "SBC abs,Y", "NOP*", "ISB abs,Y*", "NOP abs,X*", "SBC abs,X", "INC abs,X", "ISB abs,X*",
+};
+
+static uint64_t m6502_tick(uint64_t pins, void* user_data) {
+    (void)user_data;
+    const uint16_t addr = M6502_GET_ADDR(pins);
+    if (pins & M6502_RW) {
+        M6502_SET_DATA(pins, ops.mem[addr]);
+    }
+    else if ((addr < M6502_RO_START) || (addr >= M6502_RO_END)) {
+        ops.mem[addr] = M6502_GET_DATA(pins);
+    }
+    return pins;
+}
+
+static uint64_t m6502_tick_count(uint64_t pins, void* user_data) {
+    if ((pins & M6502_SYNC) && (M6502_GET_ADDR(pins) == ops.watch_addr)) {
+        ops.watch_count++;
+    }
+    return m6502_tick(pins, user_data);
+}
+
+static int m6502_len(int op) {
+    const int col = op & 0x1F;
+    switch (col) {
+        case 0x00: return (op == 0x20) ? 3 : (((op == 0x00) || (op == 0x40) || (op == 0x60)) ? 1 : 2);
+        case 0x02: return (op < 0x80) ? 1 : 2;
+        case 0x12: case 0x08: case 0x0A: case 0x18: case 0x1A: return 1;
+        case 0x0C: case 0x0D: case 0x0E: case 0x0F:
+        case 0x19: case 0x1B: case 0x1C: case 0x1D: case 0x1E: case 0x1F: return 3;
+        default: return 2;
+    }
+}
+
+static m6502_t m6502;
+
+static void m6502_bench_op(int op) {
+    const int len = m6502_len(op);
+    flow_t flow = FLOW_NORMAL;
+    int copies = OPS_NUM_COPIES;
+    uint8_t sp = 0xFF;
+    if (op == 0x00) {
+        flow = FLOW_SELF;       /* BRK, IRQ vector points to itself */
+        copies = 1;
+    }
+    else if ((op == 0x20) || (op == 0x4C) || (op == 0x6C)) {
+        flow = FLOW_JUMP;
+    }
+    else if (op == 0x60) {
+        flow = FLOW_RET;        /* RTS pops 2 bytes */
+        copies = 127;
+        sp = 0x00;
+    }
+    else if (op == 0x40) {
+        flow = FLOW_RET;        /* RTI pops 3 bytes */
+        copies = 85;
+        sp = 0x00;
+    }
+
+    /* zero page holds pointers to the data area */
+    memset(ops.mem, 0, sizeof(ops.mem));
+    memset(ops.mem, M6502_DATA_ADDR >> 8, 0x100);
+    const uint16_t start = M6502_CODE_ADDR;
+    for (int i = 0; i < copies; i++) {
+        const uint16_t addr = start + i * len;
+        const uint16_t next = addr + len;
+        uint8_t* m = &ops.mem[addr];
+        m[0] = op;
+        if (len == 2) {
+            /* branches get offset 0, everything else a zero page address or immediate */
+            m[1] = ((op & 0x1F) == 0x10) ? 0x00 : M6502_ZP_ADDR;
+        }
+        else if (len == 3) {
+            uint16_t nn = M6502_DATA_ADDR;
+            if (op == 0x6C) {
+                /* JMP (ind): pointer to the next copy */
+                nn = M6502_DATA_ADDR + 2 * i;
+                ops.mem[nn] = next & 0xFF;
+                ops.mem[nn + 1] = next >> 8;
+            }
+            else if (flow == FLOW_JUMP) {
+                nn = next;
+            }
+            m[1] = nn & 0xFF;
+            m[2] = nn >> 8;
+        }
+        if (op == 0x60) {
+            ops.mem[0x0101 + 2 * i] = (next - 1) & 0xFF;
+            ops.mem[0x0102 + 2 * i] = (next - 1) >> 8;
+        }
+        else if (op == 0x40) {
+            ops.mem[0x0101 + 3 * i] = M6502_IF|M6502_XF;
+            ops.mem[0x0102 + 3 * i] = next & 0xFF;
+            ops.mem[0x0103 + 3 * i] = next >> 8;
+        }
+    }
+    ops.mem[0xFFFE] = start & 0xFF;
+    ops.mem[0xFFFF] = start >> 8;
+    const uint16_t end = start + copies * len;
+    ops.watch_addr = start;
+
+    m6502_desc_t desc = { .tick_cb = (flow == FLOW_SELF) ? m6502_tick_count : m6502_tick };
+    m6502_init(&m6502, &desc);
+    if (flow != FLOW_SELF) {
+        m6502_set_trap(&m6502, 0, end);
+    }
+
+    uint64_t instr = 0, ticks = 0;
+    int passes = 0;
+    #define M6502_PASS() { \
+        m6502.state.A = 0x55; m6502.state.X = 0x10; m6502.state.Y = 0x10; \
+        m6502.state.S = sp; m6502.state.P = M6502_IF|M6502_XF; m6502.state.PC = start; \
+        if (flow == FLOW_SELF) { \
+            ops.watch_count = 0; \
+            ticks += m6502_exec(&m6502, OPS_SELF_LOOP_TICKS); \
+            instr += ops.watch_count; \
+        } \
+        else { \
+            ticks += m6502_exec(&m6502, 0xFFFFFFFF); \
+            instr += copies; \
+        } \
+    }
+    const double t0 = now_ms();
+    do {
+        M6502_PASS();
+        passes++;
+    } while ((now_ms() - t0) < ops.trial_ms);
+    const double tpi = (double)ticks / instr;
+
+    double best = 1e30;
+    for (int t = 0; t < ops.num_trials; t++) {
+        instr = 0;
+        const double t1 = now_ms();
+        for (int p = 0; p < passes; p++) {
+            M6502_PASS();
+        }
+        const double ms = now_ms() - t1;
+        const double ns = (ms * 1000000.0) / instr;
+        if (ns < best) {
+            best = ns;
+        }
+    }
+    #undef M6502_PASS
+    result_t* res = &ops.results[ops.num_results++];
+    res->cpu = "m6502";
+    res->prefix = "";
+    res->opcode = op;
+    snprintf(res->name, sizeof(res->name), "%s", m6502_names[op]);
+    res->num_bytes = len;
+    res->tstates = tpi;
+    res->ns_per_instr = best;
+    res->ns_per_tstate = best / tpi;
+}
+
+static void m6502_bench(void) {
+    for (int op = 0; op < 256; op++) {
+        m6502_bench_op(op);
+    }
+}
+
+/*=== OUTPUT =================================================================*/
+static int cmp_ns_per_tstate(const void* a, const void* b) {
+    const result_t* x = *(const result_t* const*)a;
+    const result_t* y = *(const result_t* const*)b;
+    return (x->ns_per_tstate < y->ns_per_tstate) ? 1 : (x->ns_per_tstate > y->ns_per_tstate) ? -1 : 0;
+}
+
+static void print_summary(const char* cpu) {
+    static const char* groups[] = { "", "CB", "ED", "DD", "FD", "DDCB", "FDCB" };
+    printf("%-6s %-6s %5s %12s %12s %12s\n", cpu, "prefix", "ops", "ns/instr", "ns/T-state", "max ns/T");
+    for (int g = 0; g < 7; g++) {
+        int n = 0;
+        double sum_i = 0, sum_t = 0, max_t = 0;
+        for (int i = 0; i < ops.num_results; i++) {
+            const result_t* r = &ops.results[i];
+            if (strcmp(r->cpu, cpu) || strcmp(r->prefix, groups[g])) {
+                continue;
+            }
+            n++;
+            sum_i += r->ns_per_instr;
+            sum_t += r->ns_per_tstate;
+            if (r->ns_per_tstate > max_t) {
+                max_t = r->ns_per_tstate;
+            }
+        }
+        if (n > 0) {
+            printf("%-6s %-6s %5d %12.2f %12.3f %12.3f\n", "", groups[g][0] ? groups[g] : "-", n, sum_i / n, sum_t / n, max_t);
+        }
+    }
+
+    const result_t* sorted[OPS_MAX_RESULTS];
+    int n = 0;
+    for (int i = 0; i < ops.num_results; i++) {
+        if (0 == strcmp(ops.results[i].cpu, cpu)) {
+            sorted[n++] = &ops.results[i];
+        }
+    }
+    qsort(sorted, n, sizeof(sorted[0]), cmp_ns_per_tstate);
+    printf("\nslowest %s opcodes (ns per T-state):\n", cpu);
+    printf("  %-9s %-18s %5s %8s %10s %10s\n", "opcode", "name", "bytes", "T", "ns/instr", "ns/T");
+    for (int i = 0; (i < n) && (i < ops.top); i++) {
+        char code[16];
+        snprintf(code, sizeof(code), "%s%s%02X", sorted[i]->prefix, sorted[i]->prefix[0] ? " " : "", sorted[i]->opcode);
+        printf("  %-9s %-18s %5d %8.2f %10.2f %10.3f\n", code, sorted[i]->name, sorted[i]->num_bytes,
+            sorted[i]->tstates, sorted[i]->ns_per_instr, sorted[i]->ns_per_tstate);
+    }
+    printf("\n");
+}
+
+static void write_csv(void) {
+    FILE* fp = fopen(ops.csv_path, "w");
+    if (!fp) {
+        fprintf(stderr, "ops-bench: failed to open %s\n", ops.csv_path);
+        exit(2);
+    }
+    fprintf(fp, "cpu,prefix,opcode,name,bytes,tstates,ns_per_instr,ns_per_tstate\n");
+    for (int i = 0; i < ops.num_results; i++) {
+        const result_t* r = &ops.results[i];
+        fprintf(fp, "%s,%s,%02X,\"%s\",%d,%.2f,%.3f,%.4f\n", r->cpu, r->prefix, r->opcode, r->name,
+            r->num_bytes, r->tstates, r->ns_per_instr, r->ns_per_tstate);
+    }
+    fclose(fp);
+}
+
+int main(int argc, char* argv[]) {
+    int opt;
+    while ((opt = getopt(argc, argv, "t:r:c:k:q")) != -1) {
+        switch (opt) {
+            case 't': ops.trial_ms = atof(optarg); break;
+            case 'r': ops.num_trials = atoi(optarg); break;
+            case 'c': ops.csv_path = optarg; break;
+            case 'k': ops.top = atoi(optarg); break;
+            case 'q': ops.quiet = true; break;
+            default: usage();
+        }
+    }
+    if ((ops.trial_ms <= 0) || (ops.num_trials < 1)) {
+        usage();
+    }
+    bool do_z80 = (optind == argc), do_m6502 = (optind == argc);
+    for (int a = optind; a < argc; a++) {
+        if (0 == strcmp(argv[a], "z80")) do_z80 = true;
+        else if (0 == strcmp(argv[a], "m6502")) do_m6502 = true;
+        else usage();
+    }
+    if (do_z80) {
+        z80_bench();
+    }
+    if (do_m6502) {
+        m6502_bench();
+    }
+    if (!ops.quiet) {
+        if (do_z80) print_summary("z80");
+        if (do_m6502) print_summary("m6502");
+    }
+    if (ops.csv_path) {
+        write_csv();
+    }
+    return 0;
+}
@@ -0,0 +1,24 @@
+# per-opcode microbenchmark for z80_exec and m6502_exec
+#
+# Builds ops-bench.c (the Z80 and 6502 from impl/) with CC and CFLAGS,
+# runs every Z80 opcode (including the CB, ED, DD, FD, DD CB and FD CB
+# prefixed ones) and all 256 6502 opcodes in a tight loop with a
+# memory-only tick callback, and writes host ns per emulated instruction
+# and per T-state for each opcode to ops-bench.csv. Prints a summary per
+# prefix group and the TOP slowest opcodes (by ns per T-state). Extra
+# arguments are passed to ops-bench (e.g. z80 or m6502).
+#
+# Environment:
+#   CC=cc           compiler
+#   CFLAGS=-O2      compile flags
+#   TRIAL_MS=2      minimum duration of one timed trial per opcode
+#   TRIALS=5        timed trials per opcode (the fastest counts)
+#   TOP=20          number of slowest opcodes to list
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:--O2}
+TRIAL_MS=${TRIAL_MS:-2}
+TRIALS=${TRIALS:-5}
+TOP=${TOP:-20}
+
+$CC $CFLAGS -o ops-bench ops-bench.c || exit 1
+./ops-bench -t $TRIAL_MS -r $TRIALS -k $TOP -c ops-bench.csv "$@"
@@ -0,0 +1,98 @@
+# large-project build simulation
+#
+# Generates fake projects with N C++ translation units. Each TU includes
+# the headers of one emulated system (with the chip headers it needs) from
+# decl/ or orig/, every 4th TU also includes the sokol app/gfx/audio
+# headers like a frontend file would, and all TUs include <vector> like
+# stdvector.cc. Each project is built through a generated Makefile
+# (make -B -jN) and build.ninja (if ninja is installed) at several -j
+# levels. Reports wall time, CPU time (compiler processes included),
+# speedup and scaling efficiency over -j1. Results go to project.csv.
+#
+# Environment:
+#   CXX=c++                 compiler
+#   DIR=decl                header directory (decl, orig or decl-nocomments)
+#   SIZES="50 200 1000"     number of TUs per project
+#   JOBS="1 2 4 <nproc>"    -j levels
+#   RUNS=3                  timed builds per variant
+CXX=${CXX:-c++}
+DIR=${DIR:-decl}
+SIZES=${SIZES:-"50 200 1000"}
+JOBS=${JOBS:-$(echo 1 2 4 $(nproc) | tr ' ' '\n' | sort -nu | tr '\n' ' ')}
+RUNS=${RUNS:-3}
+OUT=_project
+
+. ./common.sh
+
+cc -O2 -o bench bench.c -lm || exit 1
+rm -rf $OUT && mkdir -p $OUT
+
+# generate one TU
+gen_tu() {
+    local i=$1 sys=$2
+    echo "#include <vector>"
+    includes $(deps $sys) $sys
+    if [ $((i % 4)) -eq 0 ]; then
+        includes sokol_app sokol_gfx sokol_audio sokol_time
+    fi
+    echo ""
+    echo "int tu_$i(std::vector<${sys}_t*>& systems) {"
+    echo "    int n = 0;"
+    echo "    for (${sys}_t* sys : systems) {"
+    echo "        n += (int)sizeof(*sys);"
+    echo "    }"
+    echo "    return n + $i;"
+    echo "}"
+}
+
+set --
+for n in $SIZES; do
+    P=$OUT/p$n
+    mkdir -p $P
+    SYS=($SYSTEMS)
+    OBJS=""
+    for ((i = 0; i < n; i++)); do
+        gen_tu $i ${SYS[$((i % ${#SYS[@]}))]} > $P/tu_$i.cc
+        OBJS="$OBJS tu_$i.o"
+    done
+    cat > $P/Makefile <<MAKEFILE
+CXX = $CXX
+CXXFLAGS = -I../.. -O0
+OBJS = $OBJS
+all: \$(OBJS)
+%.o: %.cc
+	\$(CXX) \$(CXXFLAGS) -c \$< -o \$@
+MAKEFILE
+    {
+        echo "cxx = $CXX"
+        echo "rule cxx"
+        echo "  command = \$cxx -I../.. -O0 -c \$in -o \$out"
+        for ((i = 0; i < n; i++)); do
+            echo "build tu_$i.o: cxx tu_$i.cc"
+        done
+    } > $P/build.ninja
+    # ninja has no 'rebuild all' flag, touch the sources instead of deleting
+    # the objects so that it only pays for the rebuild like 'make -B'
+    printf 'cd %s && touch *.cc && ninja -j$1 > /dev/null\n' $P > $OUT/ninja-p$n.sh
+    for j in $JOBS; do
+        set -- "$@" "make-p$n-j$j" "make -s -B -j$j -C $P"
+        if command -v ninja > /dev/null; then
+            set -- "$@" "ninja-p$n-j$j" "bash $OUT/ninja-p$n.sh $j"
+        fi
+    done
+done
+./bench -w 0 -n $RUNS -c project.csv "$@" > /dev/null || exit 1
+
+awk -F, 'NR > 1 {
+        name[NR] = $1; t[$1] = $4; cpu[$1] = $9
+        base = $1; sub(/-j[0-9]+$/, "-j1", base); basename[NR] = base
+        j = $1; sub(/.*-j/, "", j); jobs[NR] = j
+    }
+    END {
+        printf "%-20s %10s %10s %8s %10s %9s\n", "variant", "wall s", "cpu s", "speedup", "efficiency", "ms per TU"
+        for (i = 2; i <= NR; i++) {
+            s = t[basename[i]] / t[name[i]]
+            tus = name[i]; sub(/^[a-z]+-p/, "", tus); sub(/-j.*/, "", tus)
+            printf "%-20s %10.2f %10.2f %8.2f %9.0f%% %9.1f\n", name[i], t[name[i]] / 1000, cpu[name[i]] / 1000, s, 100 * s / jobs[i], cpu[name[i]] / tus
+        }
+    }' project.csv
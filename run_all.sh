@@ -1,25 +1,36 @@
-echo "=== empty_c.sh"
-time ./empty_c.sh
-time ./empty_c.sh
-echo "=== empty_cc.sh"
-time ./empty_cc.sh
-time ./empty_cc.sh
-echo "=== decl-orig.sh"
-time ./decl-orig.sh
-time ./decl-orig.sh
-echo "=== decl-only.sh"
-time ./decl-only.sh
-time ./decl-only.sh
-echo "=== decl-nocomments.sh"
-time ./decl-nocomments.sh
-time ./decl-nocomments.sh
-echo "=== stdvector.sh"
-time ./stdvector.sh
-time ./stdvector.sh
-echo "=== crt_c99_c.sh"
-time ./crt_c99_c.sh
-time ./crt_c99_c.sh
-echo "=== crt_c99_cc.sh"
-time ./crt_c99_cc.sh
-time ./crt_c99_cc.sh
+# build the benchmark runner and time all variants with it, results
+# go to results.json and results.csv (override runs with RUNS=N, and
+# the compiler with CC=... and CXX=...), any arguments are passed on
+# to bench (e.g. '-b baseline.json' to compare against a baseline),
+# the table expresses each variant's cost as multiple of <vector>
+CC=${CC:-cc}
+CXX=${CXX:-c++}
+RUNS=${RUNS:-100}
 
+# standard library baselines, each stdX.cc includes <X>
+STDHEADERS="string map unordered_map algorithm memory iostream functional chrono thread atomic"
+STD_NAMES=""
+STD_VARIANTS=()
+for h in $STDHEADERS; do
+    STD_NAMES="$STD_NAMES,std$h"
+    STD_VARIANTS+=("std$h" "$CXX -c std$h.cc -o std$h.o")
+done
+
+cc -O2 -o bench bench.c -lm || exit 1
+./bench -w 5 -n $RUNS -j results.json -c results.csv \
+    -m "cc=$($CC --version | head -1)" \
+    -m "cxx=$($CXX --version | head -1)" \
+    -m "host=$(uname -srm)" \
+    -r empty_c:decl-orig,decl-only,decl-nocomments,crt_c99_c \
+    -r empty_cc:stdvector,crt_c99_cc$STD_NAMES \
+    -u stdvector \
+    "$@" \
+    empty_c         "$CC -c empty.c -o empty.o" \
+    empty_cc        "$CXX -c empty.cc -o empty.o" \
+    decl-orig       "$CC -c decl-orig.c -o decl-orig.o" \
+    decl-only       "$CC -c decl-only.c -o decl-only.o" \
+    decl-nocomments "$CC -c decl-nocomments.c -o decl-nocomments.o" \
+    stdvector       "$CXX -c stdvector.cc -o stdvector.o" \
+    crt_c99_c       "$CC -c crt_c99.c -o crt_c99.o" \
+    crt_c99_cc      "$CXX -c crt_c99.cc -o crt_c99.o" \
+    "${STD_VARIANTS[@]}"
@@ -0,0 +1 @@
+for ((i=0;i<1000;i++)); do cc -c stdatomic.cc -o stdatomic.o; done
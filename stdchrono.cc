@@ -0,0 +1 @@
+#include <chrono>
@@ -0,0 +1 @@
+#include <functional>
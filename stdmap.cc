@@ -0,0 +1 @@
+#include <map>
@@ -0,0 +1 @@
+#include <memory>
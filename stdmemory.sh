@@ -0,0 +1 @@
+for ((i=0;i<1000;i++)); do cc -c stdmemory.cc -o stdmemory.o; done
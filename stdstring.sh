@@ -0,0 +1 @@
+for ((i=0;i<1000;i++)); do cc -c stdstring.cc -o stdstring.o; done
@@ -0,0 +1 @@
+for ((i=0;i<1000;i++)); do cc -c stdthread.cc -o stdthread.o; done
@@ -0,0 +1 @@
+#include <unordered_map>
@@ -0,0 +1 @@
+for ((i=0;i<1000;i++)); do cc -c stdunordered_map.cc -o stdunordered_map.o; done
@@ -0,0 +1,230 @@
+# synthetic header scaling suite and compile-cost model
+#
+# Generates synthetic headers in the style of the chips headers which vary
+# one construct at a time:
+#
+#   comment_kb  KBytes of block comments (like the header docs)
+#   impl_kb     KBytes of code in a skipped CHIPS_IMPL block
+#   externs     number of extern function declarations
+#   inlines     number of static inline functions (like beeper_tick)
+#   macros      number of #define's (like the pin masks)
+#   fields      number of struct fields (in structs of 16 fields each)
+#
+# Each synthetic header is compiled (-c) in its own TU, and a linear
+# model 'ms = base + sum(coeff * count)' is fitted by least squares.
+# The model is then applied to the counts in each real header in orig/
+# and prints the predicted cost split by construct, next to the measured
+# isolated cost from headers.csv (if ./headers.sh was run before). The
+# coefficients are written to synth-model.csv.
+#
+# Environment:
+#   CC=cc      compiler
+#   RUNS=10    timed runs per synthetic header
+CC=${CC:-cc}
+RUNS=${RUNS:-10}
+OUT=_synth
+DIR=orig
+
+. ./common.sh
+
+CONSTRUCTS="comment_kb impl_kb externs inlines macros fields"
+
+# sweep levels per construct (the others are 0)
+levels() {
+    case $1 in
+        comment_kb|impl_kb) echo "32 64 128 256" ;;
+        externs|macros) echo "125 250 500 1000" ;;
+        inlines) echo "50 100 200 400" ;;
+        fields) echo "250 500 1000 2000" ;;
+    esac
+}
+
+# generate a synthetic header: gen comment_kb impl_kb externs inlines macros fields
+gen() {
+    awk -v comment_kb=$1 -v impl_kb=$2 -v externs=$3 -v inlines=$4 -v macros=$5 -v fields=$6 '
+    function comment_block(bytes,    n) {
+        print "/*"
+        n = 0
+        while (n < bytes) {
+            line = "    Lorem ipsum doc line " n ", see synth_init() and the SYNTH_PIN_* masks."
+            print line
+            n += length(line) + 1
+        }
+        print "*/"
+    }
+    BEGIN {
+        print "#pragma once"
+        comment_block(comment_kb * 512)
+        print "#include <stdint.h>"
+        print "#include <stdbool.h>"
+        print ""
+        print "#ifdef __cplusplus"
+        print "extern \"C\" {"
+        print "#endif"
+        print ""
+        print "#define SYNTH_FIXEDPOINT_SCALE (16)"
+        for (i = 0; i < macros; i++) {
+            printf "#define SYNTH_PIN_%d (1ULL<<%d)\n", i, i % 64
+        }
+        print ""
+        print "typedef struct {"
+        print "    int state;"
+        print "    int period;"
+        print "    int counter;"
+        print "    float mag;"
+        print "    float sample;"
+        print "} synth_t;"
+        types[0] = "uint8_t"; types[1] = "uint16_t"; types[2] = "uint32_t"; types[3] = "uint64_t"
+        for (i = 0; i < fields; i++) {
+            if ((i % 16) == 0) print "typedef struct {"
+            printf "    %s field_%d;\n", types[i % 4], i
+            if (((i % 16) == 15) || (i == fields - 1)) printf "} synth_struct_%d_t;\n", int(i / 16)
+        }
+        print ""
+        for (i = 0; i < externs; i++) {
+            printf "extern void synth_func_%d(synth_t* sys, int tick_hz, uint32_t pins);\n", i
+        }
+        for (i = 0; i < inlines; i++) {
+            printf "static inline bool synth_tick_%d(synth_t* s) {\n", i
+            print "    s->counter -= SYNTH_FIXEDPOINT_SCALE;"
+            print "    if (s->counter <= 0) {"
+            print "        s->counter += s->period;"
+            print "        s->sample = ((float)s->state) * s->mag;"
+            print "        return true;"
+            print "    }"
+            print "    return false;"
+            print "}"
+        }
+        print ""
+        print "#ifdef __cplusplus"
+        print "} /* extern \"C\" */"
+        print "#endif"
+        comment_block(comment_kb * 512)
+        print "/*-- IMPLEMENTATION ----------------------------------------------------------*/"
+        print "#ifdef CHIPS_IMPL"
+        n = 0
+        i = 0
+        while (n < impl_kb * 1024) {
+            line = sprintf("void synth_impl_%d(synth_t* s, int tick_hz) {\n    s->period = (tick_hz * SYNTH_FIXEDPOINT_SCALE) / 1000;\n    s->counter = s->period;\n}", i++)
+            print line
+            n += length(line) + 1
+        }
+        print "#endif /* CHIPS_IMPL */"
+    }'
+}
+
+# count the constructs in a real header, uses the generated decl/ and
+# decl-nocomments/ variants to get comment and implementation bytes
+count() {
+    local orig=$(wc -c < orig/$1.h) decl=$(wc -c < decl/$1.h) nocomm=$(wc -c < decl-nocomments/$1.h)
+    awk -v comment_bytes=$((decl - nocomm)) -v impl_bytes=$((orig - decl)) '
+        /^(extern|SOKOL_API_DECL) / { externs++ }
+        /static inline/ { inlines++ }
+        /^[ \t]*#[ \t]*define/ { macros++ }
+        /^[ \t]*(typedef )?(struct|union)[^;]*\{[ \t]*$/ { depth++; next }
+        depth > 0 && /^[ \t]*\}/ { depth--; next }
+        depth > 0 && /;[ \t]*$/ { fields++ }
+        END { printf "%.1f %.1f %d %d %d %d\n", comment_bytes / 1024, impl_bytes / 1024, externs, inlines, macros, fields }
+    ' decl-nocomments/$1.h
+}
+
+cc -O2 -o bench bench.c -lm || exit 1
+rm -rf $OUT && mkdir -p $OUT
+
+# the sweep points: the all-zero base, each construct on its own, and all
+# constructs combined at their first and last level
+echo "name $CONSTRUCTS" > $OUT/points.txt
+echo "base 0 0 0 0 0 0" >> $OUT/points.txt
+i=0
+for c in $CONSTRUCTS; do
+    for l in $(levels $c); do
+        set -- 0 0 0 0 0 0
+        case $c in
+            comment_kb) set -- $l 0 0 0 0 0 ;;
+            impl_kb)    set -- 0 $l 0 0 0 0 ;;
+            externs)    set -- 0 0 $l 0 0 0 ;;
+            inlines)    set -- 0 0 0 $l 0 0 ;;
+            macros)     set -- 0 0 0 0 $l 0 ;;
+            fields)     set -- 0 0 0 0 0 $l ;;
+        esac
+        echo "$c-$l $*" >> $OUT/points.txt
+    done
+done
+echo "all-low 32 32 125 50 125 250" >> $OUT/points.txt
+echo "all-high 256 256 1000 400 1000 2000" >> $OUT/points.txt
+
+set --
+while read name a b c d e f; do
+    [ "$name" = name ] && continue
+    gen $a $b $c $d $e $f > $OUT/$name.h
+    echo "#include \"$name.h\"" > $OUT/$name.c
+    set -- "$@" "$name" "$CC -c $OUT/$name.c -o $OUT/$name.o"
+done < $OUT/points.txt
+./bench -w 2 -n $RUNS -c $OUT/synth.csv "$@" > /dev/null || exit 1
+
+# count the constructs in the real headers
+for h in $HEADERS; do
+    echo "$h $(count $h)"
+done > $OUT/real.txt
+
+# fit the model (normal equations solved with Gaussian elimination) and
+# apply it to the real headers
+awk -v constructs="$CONSTRUCTS" -v model=synth-model.csv '
+    FILENAME ~ /synth.csv$/ { if (FNR > 1) t[$1] = $4; next }
+    FILENAME ~ /points.txt$/ {
+        if (FNR == 1) next
+        n++
+        y[n] = t[$1]
+        x[n, 0] = 1
+        for (k = 1; k <= 6; k++) x[n, k] = $(k + 1)
+        next
+    }
+    FILENAME ~ /headers.csv$/ { if (FNR > 1) measured[$1] = $10; next }
+    { real[++nr] = $0 }
+    END {
+        p = 7
+        for (i = 0; i < p; i++) {
+            for (j = 0; j < p; j++) {
+                a[i, j] = 0
+                for (r = 1; r <= n; r++) a[i, j] += x[r, i] * x[r, j]
+            }
+            a[i, p] = 0
+            for (r = 1; r <= n; r++) a[i, p] += x[r, i] * y[r]
+        }
+        for (i = 0; i < p; i++) {
+            piv = i
+            for (r = i + 1; r < p; r++) if ((a[r, i] ^ 2) > (a[piv, i] ^ 2)) piv = r
+            for (j = 0; j <= p; j++) { tmp = a[i, j]; a[i, j] = a[piv, j]; a[piv, j] = tmp }
+            for (r = 0; r < p; r++) {
+                if (r == i) continue
+                fac = a[r, i] / a[i, i]
+                for (j = i; j <= p; j++) a[r, j] -= fac * a[i, j]
+            }
+        }
+        for (i = 0; i < p; i++) coeff[i] = a[i, p] / a[i, i]
+        split(constructs, name, " ")
+        print "construct,ms_per_unit" > model
+        print "base," coeff[0] > model
+        printf "cost model (ms per unit, fitted over %d synthetic headers):\n", n
+        printf "  %-12s %10.4f\n", "base", coeff[0]
+        for (k = 1; k <= 6; k++) {
+            printf "  %-12s %10.4f\n", name[k], coeff[k]
+            print name[k] "," coeff[k] > model
+        }
+        printf "\n%-12s |", "header"
+        for (k = 1; k <= 6; k++) printf " %10s", name[k]
+        printf " | %9s %9s\n", "predicted", "measured"
+        for (i = 1; i <= nr; i++) {
+            split(real[i], f, " ")
+            printf "%-12s |", f[1]
+            total = 0
+            for (k = 1; k <= 6; k++) {
+                ms = coeff[k] * f[k + 1]
+                total += ms
+                printf " %7.2fms", ms
+            }
+            printf " | %7.2fms", total
+            if (f[1] in measured) printf " %7.2fms", measured[f[1]]
+            printf "\n"
+        }
+    }' FS=, $OUT/synth.csv FS=' ' $OUT/points.txt FS=, $( [ -f headers.csv ] && echo headers.csv ) FS=' ' $OUT/real.txt